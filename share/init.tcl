@@ -7,6 +7,7 @@ variable tabcompletion_proc_insensitive
 variable help_text
 variable help_proc
 variable lazy [dict create]
+variable lazy_procs [dict create]
 
 # Only execute this script once. Below we source other Tcl script,
 # so this makes sure we don't get in an infinite loop.
@@ -24,27 +25,55 @@ proc dbg {msg} {
 # 'procs' is about to be executed. See also 'lazy.tcl'.
 proc register_lazy {script procs} {
 	variable lazy
+	variable lazy_procs
 	dict set lazy $script $procs
+	# Reverse index (proc name -> script) so that 'lazy_handler' (called for
+	# every unknown command) doesn't have to scan all registered scripts.
+	# In case of duplicates the first registered script wins.
+	foreach proc $procs {
+		if {![dict exists $lazy_procs $proc]} {
+			dict set lazy_procs $proc $script
+		}
+	}
+}
+
+# Remove 'script' from the collection of yet-to-be-executed lazy scripts.
+proc lazy_unregister {script} {
+	variable lazy
+	variable lazy_procs
+	set procs [dict get $lazy $script]
+	dict unset lazy $script
+	foreach proc $procs {
+		if {![dict exists $lazy_procs $proc] ||
+		    [dict get $lazy_procs $proc] ne $script} continue
+		dict unset lazy_procs $proc
+		# If another (later registered) script also provides this proc,
+		# the index now points to that script.
+		dict for {other other_procs} $lazy {
+			if {$proc in $other_procs} {
+				dict set lazy_procs $proc $other
+				break
+			}
+		}
+	}
 }
 
 # Lookup the script associated with the given proc name. If found that script
 # is executed (and the script+proc-names are removed from the list of
 # yet-to-be-executed lazy scripts).
 proc lazy_handler {name} {
-	variable lazy
+	variable lazy_procs
 	set name [namespace tail $name]
-	dict for {script procs} $lazy {
-		if {[lsearch -exact $procs $name] == -1} continue
-		dict unset lazy $script
-		dbg "start executing script $script (via lazy_handler)"
-		if {[catch {namespace eval :: [list source [data_file scripts/$script]]}]} {
-			puts stderr "Error while (lazily) loading Tcl script: $script\n$::errorInfo"
-			error $::errorInfo
-		}
-		dbg "done executing script $script"
-		return true
+	if {![dict exists $lazy_procs $name]} {return false}
+	set script [dict get $lazy_procs $name]
+	lazy_unregister $script
+	dbg "start executing script $script (via lazy_handler)"
+	if {[catch {namespace eval :: [list source [data_file scripts/$script]]}]} {
+		puts stderr "Error while (lazily) loading Tcl script: $script\n$::errorInfo"
+		error $::errorInfo
 	}
-	return false
+	dbg "done executing script $script"
+	return true
 }
 
 # Execute all not yet executed lazy-scripts. ATM this is (only) required for
@@ -56,7 +85,7 @@ proc lazy_execute_all {} {
 	# trigger a load of a script later in the collection
 	while {[dict size $lazy] != 0} {
 		set script [lindex [dict keys $lazy] 0]
-		dict unset lazy $script
+		lazy_unregister $script
 		dbg "start executing script $script (via lazy_execute_all)"
 		if {[catch {namespace eval :: [list source [data_file scripts/$script]]}]} {
 			puts stderr "Error while (lazily) loading Tcl script: $script\n$::errorInfo"
@@ -72,11 +101,9 @@ proc lazy_execute_all {} {
 #   procs from not yet loaded lazy-scripts (see register_lazy).
 # This helper proc is used for tab-completion in the openMSX console.
 proc all_command_names {} {
-	variable lazy
+	variable lazy_procs
 	set result [info commands]
-	foreach procs [dict values $lazy] {
-		lappend result {*}$procs
-	}
+	lappend result {*}[dict keys $lazy_procs]
 	# only one level deep, good enough for machineN::*
 	foreach ns [namespace children ::] {
 		lappend result {*}[info commands ${ns}::*]
@@ -97,8 +124,14 @@ proc all_command_names_with_help {} {
 # loaded script. This helper proc is used for syntax-highlighting in the
 # openMSX console.
 proc is_command_name {name} {
+	variable lazy_procs
 	if {[info commands ::$name] ne ""} {return 1}
-	expr {[lsearch -exact [all_command_names] [namespace tail $name]] != -1}
+	# Same names as all_command_names (qualified names like machineN::*
+	# are handled above), but with exact lookups instead of building the
+	# full list.
+	set tail [namespace tail $name]
+	if {[dict exists $lazy_procs $tail]} {return 1}
+	expr {$tail ne "" && [namespace which -command $tail] ne ""}
 }
 
 # Override the builtin Tcl proc 'unknown'. This is called when the Tcl
@@ -214,8 +247,6 @@ foreach script [lsort -unique [concat $user_scripts $system_scripts]] {
 	set t2 [openmsx_info realtime]
 	lappend profile_list [list [expr {int(1000000 * ($t2 - $t1))}] $script]
 }
-if 0 {
-	foreach e [lsort -integer -index 0 $profile_list] { puts stderr $e }
-}
+# 'profile_list' is reported when openMSX is started with '--startup-profile'.
 
 } ;# namespace openmsx
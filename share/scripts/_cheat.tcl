@@ -28,7 +28,6 @@ Examples:
 namespace eval cheat_finder {
 
 variable max_num_results 15 ;# maximum to display cheats
-variable mem
 
 # build translation dictionary for convenience expressions
 variable translate [dict create \
@@ -70,44 +69,51 @@ proc tab_cheat_type {args} {
 
 # Restart cheat finder.
 proc start {} {
-	variable mem [dict create]
-
-	set mymem [debug read_block memory 0 0x10000]
-	binary scan $mymem c* values
-	set addr 0
-	foreach val $values {
-		dict append mem $addr $val
-		incr addr
-	}
+	debug cheat_search start memory
 }
 
-# Helper function to do the actual search.
-# Returns a list of triplets (addr, old, new)
+# Helper function to do the actual search. The expression is a Tcl
+# expression in terms of 'new', 'old' and 'addr'. Simple comparisons are
+# handled natively, other expressions are evaluated in Tcl for each of the
+# remaining candidates.
 proc search {expression} {
-	variable mem
+	set expression [string trim $expression]
+	if {$expression eq "true"} {
+		debug cheat_search update
+		return
+	}
+	if {[regexp {^new\s*(<=|>=|!=|==|<|>)\s*(old|\d+|0x[0-9a-fA-F]+)$} \
+	            $expression -> op rhs]} {
+		if {$rhs eq "old"} {
+			debug cheat_search filter $op
+			return
+		} elseif {$rhs <= 255} {
+			debug cheat_search filter $op $rhs
+			return
+		}
+	}
 
-	set result [list]
-	dict for {addr old} $mem {
-		set new [debug read memory $addr]
+	# prefix 'old', 'new' and 'addr' with '$'
+	set expression [string map {old $old new $new addr $addr} $expression]
+	debug cheat_search update
+	set keep [list]
+	foreach triplet [debug cheat_search results] {
+		lassign $triplet addr old new
 		#note: NO braces around $expression
 		if $expression {
-			dict set mem $addr $new
-			lappend result [list $addr $old $new]
-		} else {
-			dict unset mem $addr
+			lappend keep $addr
 		}
 	}
-	return $result
+	debug cheat_search keep $keep
 }
 
 # main routine
 proc findcheat {args} {
-	variable mem
 	variable max_num_results
 	variable translate
 
-	# create mem dictionary
-	if {![info exists mem]} start
+	# start a new search if there's none yet
+	if {[catch {debug cheat_search count}]} start
 
 	# parse options
 	while (1) {
@@ -135,20 +141,16 @@ proc findcheat {args} {
 		set expression "new == $expression"
 	}
 
-	# prefix 'old', 'new' and 'addr' with '$'
-	set expression [string map {old $old new $new addr $addr} $expression]
-
 	# search memory
-	set result [search $expression]
+	search $expression
 
 	# display the result
-	set num [llength $result]
+	set num [debug cheat_search count]
 	if {$num == 0} {
 		return "No results left"
 	} elseif {$num <= $max_num_results} {
 		set output ""
-		set sorted [lsort -integer -index 0 $result]
-		foreach {addr old new} [join $sorted] {
+		foreach {addr old new} [join [debug cheat_search results]] {
 			append output [format "0x%04X : %d -> %d\n" $addr $old $new]
 		}
 		return $output
@@ -11,7 +11,16 @@ proc savestate_common {} {
 	}
 }
 
-proc savestate {{name ""}} {
+proc savestate {args} {
+	set options [list]
+	if {[lindex $args 0] eq "-binary"} {
+		lappend options -binary
+		set args [lrange $args 1 end]
+	}
+	if {[llength $args] > 1} {
+		error "wrong # args: should be \"savestate ?-binary? ?name?\""
+	}
+	set name [lindex $args 0]
 	savestate_common
 	file mkdir $directory
 	if {[catch {screenshot -raw -doublesize $png}]} {
@@ -23,7 +32,7 @@ proc savestate {{name ""}} {
 		}
 	}
 	set currentID [machine]
-	store_machine $currentID $fullname
+	store_machine {*}$options $currentID $fullname
 	return $name
 }
 
@@ -98,12 +107,14 @@ proc savestate_list_tab {args} {
 
 # savestate
 set_help_text savestate \
-{savestate [<name>]
+{savestate [-binary] [<name>]
 
 Create a snapshot of the current emulated MSX machine.
 
 Optionally you can specify a name for the savestate. If you omit this the default name 'quicksave' will be taken.
 
+With -binary the snapshot is stored in a compact binary format, which is a lot faster to save and load, especially for machines with a lot of RAM. Such a snapshot can only be loaded on the same type of platform (e.g. 64-bit little endian). 'loadstate' recognizes both formats.
+
 See also 'loadstate', 'list_savestates', 'delete_savestate'.
 }
 set_tabcompletion_proc savestate [namespace code savestate_tab]
@@ -20,6 +20,7 @@ variable trainers ""
 variable active_trainer ""
 variable items_active
 variable after_id 0
+variable compiled [dict create]
 
 proc load_trainers {} {
 	variable trainers
@@ -73,6 +74,7 @@ proc trainer {args} {
 					lappend new_items [expr {$item1 ^ $item2}]
 				}
 				set items_active $new_items
+				execute
 			} else {
 				deactivate
 				set active_trainer $name
@@ -120,26 +122,102 @@ proc print {} {
 	}
 	join $result \n
 }
+# Translate the implementation of a trainer item into a list of actions for
+# the native trainer engine ('debug trainer'). Returns an empty string when
+# the item does something else than simple pokes (then it's still executed
+# in Tcl).
+proc compile_item {impl} {
+	set result [list]
+	foreach cmd [split $impl ";"] {
+		if {[catch {llength $cmd} len] || $len == 0} continue
+		lassign $cmd name addr val m
+		if {$len == 3} {
+			set m memory
+		} elseif {$len != 4 || $m ni {memory "slotted memory"}} {
+			return ""
+		}
+		if {![string is integer -strict $addr] || ![string is integer -strict $val]} {
+			return ""
+		}
+		switch -- $name {
+			poke - poke8 {
+				lappend result [list $m $addr [expr {$val & 255}]]
+			}
+			dpoke {
+				lappend result [list $m $addr [expr {$val & 255}] if_different]
+			}
+			poke16 - poke16_LE {
+				lappend result [list $m        $addr       [expr { $val       & 255}]]
+				lappend result [list $m [expr {$addr + 1}] [expr {($val >> 8) & 255}]]
+			}
+			default {
+				return ""
+			}
+		}
+	}
+	return $result
+}
+# The trainer definitions are only translated once per trainer.
+proc get_compiled {name} {
+	variable trainers
+	variable compiled
+	if {![dict exists $compiled $name]} {
+		set result [list]
+		foreach {item_name item_impl} [dict get $trainers $name items] {
+			lappend result [compile_item $item_impl]
+		}
+		dict set compiled $name $result
+	}
+	return [dict get $compiled $name]
+}
+# (Re)load the active items into the native engine. Items that couldn't be
+# translated keep running via an 'after' loop.
 proc execute {} {
 	variable trainers
 	variable active_trainer
 	variable items_active
 	variable after_id
 
+	after cancel $after_id
 	set items  [dict get $trainers $active_trainer items ]
 	set repeat [dict get $trainers $active_trainer repeat]
-	foreach {item_name item_impl} $items item_active $items_active {
-		if {$item_active} {
-			eval $item_impl
+	switch -- [lindex $repeat 0] {
+		frame   {set period frame}
+		time    {set period [lindex $repeat 1]}
+		default {set period ""}
+	}
+	set actions [list]
+	set tcl_items [list]
+	foreach {item_name item_impl} $items item_active $items_active item_actions [get_compiled $active_trainer] {
+		if {!$item_active} continue
+		if {$period ne "" && $item_actions ne ""} {
+			lappend actions {*}$item_actions
+		} else {
+			lappend tcl_items $item_impl
 		}
 	}
-	set after_id [after {*}$repeat trainer::execute]
+	if {[llength $actions]} {
+		debug trainer set $period $actions
+	} else {
+		debug trainer clear
+	}
+	if {[llength $tcl_items]} {
+		execute_tcl $tcl_items $repeat
+	}
+}
+proc execute_tcl {tcl_items repeat} {
+	variable after_id
+	foreach item_impl $tcl_items {
+		eval $item_impl
+	}
+	set after_id [after {*}$repeat [list trainer::execute_tcl $tcl_items $repeat]]
 }
 proc deactivate {} {
 	variable after_id
 	variable active_trainer
 
 	after cancel $after_id
+	catch {debug trainer clear}
 	set active_trainer ""
 }
 proc deactivate_after {event} {
@@ -151,7 +229,9 @@ deactivate_after machine_switch
 
 proc create_trainer {name repeat items} {
 	variable trainers
+	variable compiled
 	dict set trainers $name [dict create items $items repeat $repeat]
+	dict unset compiled $name
 }
 
 namespace export trainer
@@ -29,6 +29,10 @@ variable opl3_logged      false
 variable scc_plus_used
 
 variable watchpoints [list]
+# watchpoints in -log mode, pairs of watchpoint-id and chip
+variable log_watchpoints [list]
+# id of the pending 'after' of process_logs_periodically
+variable process_logs_after_id ""
 
 variable loop_amount 0
 variable position 0
@@ -280,21 +284,20 @@ proc vgm_rec_start {} {
 	variable scc_plus_used false
 
 	variable watchpoints
+	variable log_watchpoints
 
 	variable file_name
 	set recording_text "VGM recording initiated, start playback now, data will be recorded to $file_name for the following sound chips:"
 
 	variable psg_logged
 	if {$psg_logged} {
-		lappend watchpoints [debug set_watchpoint write_io 0xA0 {} {vgm::write_psg_address}] \
-		                    [debug set_watchpoint write_io 0xA1 {} {vgm::write_psg_data}]
+		lappend log_watchpoints [debug set_watchpoint -log write_io {0xA0 0xA1}] psg
 		append recording_text " PSG"
 	}
 
 	variable fm_logged
 	if {$fm_logged} {
-		lappend watchpoints [debug set_watchpoint write_io 0x7C {} {vgm::write_opll_address}] \
-		                    [debug set_watchpoint write_io 0x7D {} {vgm::write_opll_data}]
+		lappend log_watchpoints [debug set_watchpoint -log write_io {0x7C 0x7D}] opll
 		append recording_text " MSX-Music"
 	}
 
@@ -308,8 +311,7 @@ proc vgm_rec_start {} {
 	}
 	variable y8950_logged
 	if {$y8950_logged} {
-		lappend watchpoints [debug set_watchpoint write_io 0xC0 {} {vgm::write_y8950_address}] \
-		                    [debug set_watchpoint write_io 0xC1 {} {vgm::write_y8950_data}]
+		lappend log_watchpoints [debug set_watchpoint -log write_io {0xC0 0xC1}] y8950
 
 		# Save the sample RAM as a datablock. If loaded before starting the recording it's fine, if loaded afterward it'll be saved as vgm commands which will be optimised to datablock by the vgmtools
 		# Note that we only support the first Y8950 device on the I/O port
@@ -336,12 +338,8 @@ proc vgm_rec_start {} {
 	# http://www.msxarchive.nl/pub/msx/docs/programming/opl4tech.txt
 	variable moonsound_logged
 	if {$moonsound_logged} {
-		lappend watchpoints [debug set_watchpoint write_io 0x7E {} {vgm::write_opl4_address_wave}] \
-		                    [debug set_watchpoint write_io 0x7F {} {vgm::write_opl4_data_wave}] \
-		                    [debug set_watchpoint write_io 0xC4 {} {vgm::write_opl4_address_1}] \
-		                    [debug set_watchpoint write_io 0xC5 {} {vgm::write_opl4_data}] \
-		                    [debug set_watchpoint write_io 0xC6 {} {vgm::write_opl4_address_2}] \
-		                    [debug set_watchpoint write_io 0xC7 {} {vgm::write_opl4_data}]
+		lappend log_watchpoints [debug set_watchpoint -log write_io {0x7E 0x7F}] opl4_wave \
+		                        [debug set_watchpoint -log write_io {0xC4 0xC7}] opl4
 
 		# Save the sample RAM as a datablock. If loaded before starting the recording it's fine, if loaded afterward it'll be saved as vgm commands which will be optimised to datablock by the vgmtools
 		# Note that we only support the first MoonSound device on the I/O port
@@ -363,14 +361,7 @@ proc vgm_rec_start {} {
 	}
 	variable opl3_logged
 	if {$opl3_logged} {
-		lappend watchpoints [debug set_watchpoint write_io 0xC0 {} {vgm::write_opl3_address_1}] \
-		                    [debug set_watchpoint write_io 0xC1 {} {vgm::write_opl3_data}] \
-		                    [debug set_watchpoint write_io 0xC2 {} {vgm::write_opl3_address_2}] \
-		                    [debug set_watchpoint write_io 0xC3 {} {vgm::write_opl3_data}] \
-		                    [debug set_watchpoint write_io 0xC4 {} {vgm::write_opl3_address_1}] \
-		                    [debug set_watchpoint write_io 0xC5 {} {vgm::write_opl3_data}] \
-		                    [debug set_watchpoint write_io 0xC6 {} {vgm::write_opl3_address_2}] \
-		                    [debug set_watchpoint write_io 0xC7 {} {vgm::write_opl3_data}]
+		lappend log_watchpoints [debug set_watchpoint -log write_io {0xC0 0xC7}] opl3
 		append recording_text " OPL3"
 	}
 
@@ -386,6 +377,10 @@ proc vgm_rec_start {} {
 		append recording_text " SCC"
 	}
 
+	if {[llength $log_watchpoints] > 0} {
+		vgm::process_logs_periodically
+	}
+
 	message $recording_text
 	return $recording_text
 }
@@ -436,29 +431,55 @@ proc find_all_sfg {} {
 	return $result
 }
 
-proc write_psg_address {} {
-	variable psg_register $::wp_last_value
+# The I/O mapped chips are recorded with watchpoints in -log mode, this avoids
+# calling a Tcl proc for every register write. The recorded writes are
+# periodically fetched and converted to VGM commands.
+proc process_logs {} {
+	variable log_watchpoints
+	set entries [list]
+	foreach {wp chip} $log_watchpoints {
+		foreach {time port value pc} [debug watchpoint_log $wp] {
+			lappend entries [list $time $chip $port $value]
+		}
+	}
+	# lsort is stable, so writes with the same time keep their order
+	foreach entry [lsort -real -index 0 $entries] {
+		lassign $entry time chip port value
+		write_$chip $port $value $time
+	}
+}
+
+proc process_logs_periodically {} {
+	variable active
+	variable process_logs_after_id
+	# when called directly (new recording), cancel the chain of a previous
+	# recording that may still be pending
+	after cancel $process_logs_after_id
+	set process_logs_after_id ""
+	if {!$active} return
+	process_logs
+	set process_logs_after_id [after time 0.1 vgm::process_logs_periodically]
 }
 
-proc write_psg_data {} {
+proc write_psg {port value time} {
 	variable psg_register
-	if {$psg_register >= 0 && $psg_register < 14} {
-		update_time
+	if {$port == 0xA0} {
+		set psg_register $value
+	} elseif {$psg_register >= 0 && $psg_register < 14} {
+		update_time $time
 		variable music_data
-		append music_data [binary format ccc 0xA0 $psg_register $::wp_last_value]
+		append music_data [binary format ccc 0xA0 $psg_register $value]
 	}
 }
 
-proc write_opll_address {} {
-	variable opll_register $::wp_last_value
-}
-
-proc write_opll_data {} {
+proc write_opll {port value time} {
 	variable opll_register
-	if {$opll_register >= 0} {
-		update_time
+	if {$port == 0x7C} {
+		set opll_register $value
+	} elseif {$opll_register >= 0} {
+		update_time $time
 		variable music_data
-		append music_data [binary format ccc 0x51 $opll_register $::wp_last_value]
+		append music_data [binary format ccc 0x51 $opll_register $value]
 	}
 }
 
@@ -468,79 +489,65 @@ proc write_y2151_address {} {
 proc write_y2151_data {} {
 	variable y2151_register
 	if {$y2151_register >= 0} { # initialised to -1
+		process_logs
 		update_time
 		variable music_data
 		append music_data [binary format ccc 0x54 $y2151_register $::wp_last_value]
 	}
 }
 
-proc write_y8950_address {} {
-	variable y8950_register $::wp_last_value
-}
-
-proc write_y8950_data {} {
+proc write_y8950 {port value time} {
 	variable y8950_register
-	if {$y8950_register >= 0} {
-		update_time
+	if {$port == 0xC0} {
+		set y8950_register $value
+	} elseif {$y8950_register >= 0} {
+		update_time $time
 		variable music_data
-		append music_data [binary format ccc 0x5C $y8950_register $::wp_last_value]
+		append music_data [binary format ccc 0x5C $y8950_register $value]
 	}
 }
 
-proc write_opl4_address_wave {} {
-	variable opl4_register_wave $::wp_last_value
-}
-
-proc write_opl4_data_wave {} {
+proc write_opl4_wave {port value time} {
 	variable opl4_register_wave
-	if {$opl4_register_wave >= 0} {
-		update_time
+	if {$port == 0x7E} {
+		set opl4_register_wave $value
+	} elseif {$opl4_register_wave >= 0} {
+		update_time $time
 		# VGM spec: Port 0 = FM1, port 1 = FM2, port 2 = Wave. It's
 		# based on the datasheet A1 & A2 use.
 		variable music_data
-		append music_data [binary format cccc 0xD0 0x2 $opl4_register_wave $::wp_last_value]
+		append music_data [binary format cccc 0xD0 0x2 $opl4_register_wave $value]
 	}
 }
 
-proc write_opl4_address_1 {} {
-	variable opl4_register $::wp_last_value
-	variable active_fm_register 0
-}
-
-proc write_opl4_address_2 {} {
-	variable opl4_register $::wp_last_value
-	variable active_fm_register 1
-}
-
-proc write_opl4_data {} {
+proc write_opl4 {port value time} {
 	variable opl4_register
 	variable active_fm_register
-	if {$opl4_register >= 0} {
-		update_time
+	if {$port == 0xC4 || $port == 0xC6} {
+		set opl4_register $value
+		set active_fm_register [expr {($port == 0xC4) ? 0 : 1}]
+	} elseif {$opl4_register >= 0} {
+		update_time $time
 		variable music_data
-		append music_data [binary format cccc 0xD0 $active_fm_register $opl4_register $::wp_last_value]
+		append music_data [binary format cccc 0xD0 $active_fm_register $opl4_register $value]
 	}
 }
 
-proc write_opl3_address_1 {} {
-	variable opl3_register $::wp_last_value
-	variable opl3_port 0xC0
-}
-
-proc write_opl3_address_2 {} {
-	variable opl3_register $::wp_last_value
-	variable opl3_port 0xC2
-}
-
-proc write_opl3_data {} {
+proc write_opl3 {port value time} {
 	variable opl3_register
-	if {$opl3_register >= 0} {
-		update_time
-		variable opl3_port
+	variable opl3_port
+	if {$port == 0xC0 || $port == 0xC4} {
+		set opl3_register $value
+		set opl3_port 0xC0
+	} elseif {$port == 0xC2 || $port == 0xC6} {
+		set opl3_register $value
+		set opl3_port 0xC2
+	} elseif {$opl3_register >= 0} {
+		update_time $time
 		variable music_data
 		switch $opl3_port {
-			0xC0 { append music_data [binary format ccc 0x5E $opl3_register $::wp_last_value] }
-			0xC2 { append music_data [binary format ccc 0x5F $opl3_register $::wp_last_value] }
+			0xC0 { append music_data [binary format ccc 0x5E $opl3_register $value] }
+			0xC2 { append music_data [binary format ccc 0x5F $opl3_register $value] }
 		}
 	}
 }
@@ -572,6 +579,7 @@ proc scc_data {} {
 	#0x04 - waveform (0x00 used to do SCC access, 0x04 SCC+)
 	#0x05 - test register
 
+	process_logs
 	update_time
 
 	variable music_data
@@ -612,6 +620,7 @@ proc scc_plus_data {} {
 	#0x04 - waveform (0x00 used to do SCC access, 0x04 SCC+)
 	#0x05 - test register
 
+	process_logs
 	update_time
 
 	variable music_data
@@ -628,15 +637,18 @@ proc scc_plus_data {} {
 	variable scc_plus_used true
 }
 
-proc update_time {} {
+proc update_time {{time ""}} {
+	if {$time eq ""} {
+		set time [machine_info time]
+	}
 	variable start_time
 	if {$start_time == 0} {
-		set start_time [machine_info time]
+		set start_time $time
 		message "VGM recording started, data was written to one of the sound chips recording for."
 	}
 
 	variable tick_time
-	set tick_time [machine_info time]
+	set tick_time $time
 	set new_ticks [expr {int(($tick_time - $start_time) * 44100)}]
 
 	variable ticks
@@ -660,8 +672,15 @@ proc vgm_rec_end {abort} {
 		error "Not recording currently..."
 	}
 
-	# remove all watchpoints that were created
+	# convert the remaining recorded writes, then remove all watchpoints
+	# that were created
+	process_logs
 	variable watchpoints
+	variable log_watchpoints
+	foreach {watch chip} $log_watchpoints {
+		lappend watchpoints $watch
+	}
+	set log_watchpoints [list]
 	foreach watch $watchpoints {
 		if {[catch {
 			debug remove_watchpoint $watch
@@ -670,6 +689,9 @@ proc vgm_rec_end {abort} {
 		}
 	}
 	set watchpoints [list]
+	variable process_logs_after_id
+	after cancel $process_logs_after_id
+	set process_logs_after_id ""
 
 	if {!$abort} {
 		update_time
@@ -811,6 +833,7 @@ proc vgm_check_audio_data_written {} {
 	variable active
 	if {!$active} return
 
+	process_logs
 	variable tick_time
 	variable auto_next
 	set now [machine_info time]
@@ -68,7 +68,6 @@ register_lazy "_text_echo.tcl" text_echo
 register_lazy "_toggle_freq.tcl" toggle_freq
 register_lazy "_trainer.tcl" {trainer load_trainers}
 register_lazy "_type_from_file.tcl" {type_from_file type_password_from_file}
-register_lazy "_type_via_keybuf.tcl" {type_via_keybuf}
 register_lazy "_utils.tcl" {
 	get_machine_display_name get_machine_display_name_by_config_name
 	get_extension_display_name_by_config_name
@@ -14,6 +14,7 @@
 #include "EnumSetting.hh"
 #include "XMLException.hh"
 #include "StringOp.hh"
+#include "Timer.hh"
 #include "xrange.hh"
 #include "Reactor.hh"
 #include "RomInfo.hh"
@@ -25,6 +26,7 @@
 #include "view.hh"
 #include "xxhash.hh"
 #include "build-info.hh"
+#include <array>
 #include <cassert>
 #include <iostream>
 #include <memory>
@@ -56,6 +58,7 @@ CommandLineParser::CommandLineParser(Reactor& reactor_)
 	registerOption("-v",          versionOption, PHASE_BEFORE_INIT, 1);
 	registerOption("--version",   versionOption, PHASE_BEFORE_INIT, 1);
 	registerOption("-bash",       bashOption,    PHASE_BEFORE_INIT, 1);
+	registerOption("--startup-profile", startupProfileOption, PHASE_BEFORE_INIT, 1);
 
 	registerOption("-setting",    settingOption, PHASE_BEFORE_SETTINGS);
 	registerOption("-control",    controlOption, PHASE_BEFORE_SETTINGS, 1);
@@ -160,6 +163,7 @@ void CommandLineParser::parse(std::span<char*> argv)
 	for (ParsePhase phase = PHASE_BEFORE_INIT;
 	     (phase <= PHASE_LAST) && (parseStatus != EXIT);
 	     phase = static_cast<ParsePhase>(phase + 1)) {
+		auto phaseStart = Timer::getTime();
 		switch (phase) {
 		case PHASE_INIT:
 			reactor.init();
@@ -256,6 +260,20 @@ void CommandLineParser::parse(std::span<char*> argv)
 			cmdLine = cmdLineBuf;
 			break;
 		}
+		if (startupProfileOption.enabled) {
+			static constexpr std::array<std::string_view, PHASE_LAST + 1> phaseNames = {
+				"parse options (before init)",
+				"init",
+				"parse options (before settings)",
+				"load settings",
+				"parse options (before machine)",
+				"load machine",
+				"load default machine",
+				"parse options (rest)",
+			};
+			startupProfileOption.timings.emplace_back(
+				phaseNames[phase], Timer::getTime() - phaseStart);
+		}
 	}
 	for (const auto& option : options) {
 		option.option->parseDone();
@@ -496,6 +514,20 @@ string_view CommandLineParser::VersionOption::optionHelp() const
 }
 
 
+// Startup profile option
+
+void CommandLineParser::StartupProfileOption::parseOption(
+	const string& /*option*/, std::span<string>& /*cmdLine*/)
+{
+	enabled = true;
+}
+
+string_view CommandLineParser::StartupProfileOption::optionHelp() const
+{
+	return "Report the time spent in the different startup phases";
+}
+
+
 // Machine option
 
 void CommandLineParser::MachineOption::parseOption(
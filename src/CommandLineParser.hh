@@ -12,12 +12,14 @@
 #include "CDImageCLI.hh"
 #include "InfoTopic.hh"
 #include "components.hh"
+#include <cstdint>
 #include <initializer_list>
 #include <memory>
 #include <optional>
 #include <span>
 #include <string>
 #include <string_view>
+#include <utility>
 #include <vector>
 
 #if COMPONENT_LASERDISC
@@ -69,6 +71,16 @@ public:
 	  */
 	[[nodiscard]] bool isHiddenStartup() const;
 
+	/** Was '--startup-profile' given? Then getStartupTimings() contains
+	  * the time (in us) spent in each of the parse phases.
+	  */
+	[[nodiscard]] bool isStartupProfile() const {
+		return startupProfileOption.enabled;
+	}
+	[[nodiscard]] const auto& getStartupTimings() const {
+		return startupProfileOption.timings;
+	}
+
 private:
 	struct OptionData {
 		OptionData(std::string_view n, CLIOption* o, ParsePhase p, unsigned l)
@@ -150,6 +162,14 @@ private:
 		[[nodiscard]] std::string_view optionHelp() const override;
 	} bashOption;
 
+	struct StartupProfileOption final : CLIOption {
+		void parseOption(const std::string& option, std::span<std::string>& cmdLine) override;
+		[[nodiscard]] std::string_view optionHelp() const override;
+
+		std::vector<std::pair<std::string_view, uint64_t>> timings;
+		bool enabled = false;
+	} startupProfileOption;
+
 	struct FileTypeCategoryInfoTopic final : InfoTopic {
 		FileTypeCategoryInfoTopic(InfoCommand& openMSXInfoCommand, const CommandLineParser& parser);
 		void execute(std::span<const TclObject> tokens, TclObject& result) const override;
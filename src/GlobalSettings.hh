@@ -36,6 +36,9 @@ public:
 	[[nodiscard]] BooleanSetting& getAutoSaveSetting() {
 		return autoSaveSetting;
 	}
+	[[nodiscard]] BooleanSetting& getUMRCheckSetting() {
+		return umrCheckSetting;
+	}
 	[[nodiscard]] StringSetting& getUMRCallBackSetting() {
 		return umrCallBackSetting;
 	}
@@ -65,6 +68,7 @@ private:
 	BooleanSetting pauseSetting;
 	BooleanSetting powerSetting;
 	BooleanSetting autoSaveSetting;
+	BooleanSetting umrCheckSetting;
 	StringSetting  umrCallBackSetting;
 	StringSetting  invalidPsgDirectionsSetting;
 	StringSetting  invalidPpiModeSetting;
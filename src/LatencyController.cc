@@ -0,0 +1,156 @@
+#include "LatencyController.hh"
+
+#include "Mixer.hh"
+#include "Reactor.hh"
+#include "SoundDriver.hh"
+#include "TclObject.hh"
+#include "Timer.hh"
+
+#include "narrow.hh"
+#include "outer.hh"
+
+#include <algorithm>
+
+namespace openmsx {
+
+static constexpr uint64_t STABLE_PERIOD = 5'000'000; // us without underruns before lowering the target
+static constexpr double ALPHA = 0.1; // smoothing factor for the reported measurements
+
+[[nodiscard]] static double smooth(double average, double sample)
+{
+	return average * (1.0 - ALPHA) + sample * ALPHA;
+}
+
+LatencyController::LatencyController(Reactor& reactor_, CommandController& commandController)
+	: reactor(reactor_)
+	, enabledSetting(commandController, "latency_control",
+		"automatically fine-tune the emulation speed (by at most 0.5%) and the "
+		"sound buffer level, to keep the audio and video latency low", false)
+	, info(reactor.getOpenMSXInfoCommand())
+{
+	enabledSetting.attach(*this);
+}
+
+LatencyController::~LatencyController()
+{
+	enabledSetting.detach(*this);
+}
+
+void LatencyController::sync(int64_t ahead)
+{
+	auto now = Timer::getTime();
+	auto dt = narrow_cast<double>(now - lastSync) * (1.0 / 1000000.0); // in s
+	lastSync = now;
+	aheadTime = smooth(aheadTime, narrow_cast<double>(ahead) * (1.0 / 1000.0));
+
+	auto& driver = reactor.getMixer().getSoundDriver();
+	auto fill = driver.getBufferFill();
+	if (fill.capacity == 0) {
+		// no sound output, so nothing to steer on
+		resetControl();
+		return;
+	}
+	auto frequency = narrow_cast<double>(driver.getFrequency());
+	audioLatency = smooth(audioLatency, fill.filled * 1000.0 / frequency);
+
+	// The counter restarts when the driver is recreated.
+	auto underruns = driver.getUnderrunCount();
+	bool underrun = underruns > lastUnderruns;
+	lastUnderruns = underruns;
+
+	if (!enabledSetting.getBoolean()) {
+		if (steeringSound) {
+			driver.setTargetFill(0); // back to the driver default
+			steeringSound = false;
+		}
+		return;
+	}
+	// Keep the setpoint as low as possible without underruns. Start at the
+	// driver default level (two fragments).
+	auto fragment = driver.getSamples();
+	auto maxSetpoint = 2 * fragment;
+	if (!steeringSound) {
+		setpoint = maxSetpoint;
+		steeringSound = true;
+	}
+	if (underrun) {
+		setpoint += fragment / 2;
+		stableSince = now;
+	} else if ((now - stableSince) > STABLE_PERIOD) {
+		setpoint -= fragment / 8;
+		stableSince = now;
+	}
+	setpoint = std::clamp(setpoint, fragment, maxSetpoint);
+	driver.setTargetFill(SoundLevelControl::getPacingLimit(setpoint, fragment));
+
+	if (dt > 1.0) {
+		// first sync after a pause: no meaningful interval
+		stableSince = now;
+		return;
+	}
+	auto error = (narrow_cast<double>(fill.filled) - narrow_cast<double>(setpoint)) / frequency; // in s
+	control.update(error, dt);
+}
+
+void LatencyController::framePresented(uint64_t duration, uint64_t time)
+{
+	paintTime = smooth(paintTime, narrow_cast<double>(duration) * (1.0 / 1000.0));
+	if (lastFrame) {
+		frameInterval = smooth(frameInterval, narrow_cast<double>(time - lastFrame) * (1.0 / 1000.0));
+	}
+	lastFrame = time;
+}
+
+void LatencyController::resetControl()
+{
+	control.reset();
+	stableSince = Timer::getTime();
+}
+
+void LatencyController::update(const Setting& /*setting*/) noexcept
+{
+	resetControl();
+}
+
+
+// class Info
+
+LatencyController::Info::Info(InfoCommand& openMSXInfoCommand)
+	: InfoTopic(openMSXInfoCommand, "latency")
+{
+}
+
+void LatencyController::Info::execute(
+	std::span<const TclObject> tokens, TclObject& result) const
+{
+	checkNumArgs(tokens, 2, "");
+	const auto& controller = OUTER(LatencyController, info);
+	auto& driver = controller.reactor.getMixer().getSoundDriver();
+	auto fill = driver.getBufferFill();
+	auto frequency = narrow_cast<double>(driver.getFrequency());
+	result.addDictKeyValues(
+		"enabled",        controller.enabledSetting.getBoolean(),
+		"speed_factor",   controller.control.getSpeedFactor(),
+		"ahead",          controller.aheadTime,
+		"audio_latency",  controller.audioLatency,
+		"audio_target",   (controller.steeringSound ? controller.setpoint : fill.target) * 1000.0 / frequency,
+		"underruns",      narrow<int>(driver.getUnderrunCount()),
+		"paint_time",     controller.paintTime,
+		"frame_interval", controller.frameInterval);
+}
+
+std::string LatencyController::Info::help(std::span<const TclObject> /*tokens*/) const
+{
+	return "Returns a dict with latency measurements (averaged, times in ms):\n"
+	       "  enabled         the value of the 'latency_control' setting\n"
+	       "  speed_factor    correction currently applied on the emulation speed\n"
+	       "  ahead           how far emulation runs ahead of real time\n"
+	       "  audio_latency   sound buffered in the output buffer\n"
+	       "  audio_target    the level the sound buffer is kept at\n"
+	       "  underruns       number of times the sound output buffer ran empty\n"
+	       "  paint_time      time to paint and present a frame (incl. vsync wait),\n"
+	       "                  this is not the full input-to-photon latency\n"
+	       "  frame_interval  time between presented frames\n";
+}
+
+} // namespace openmsx
@@ -0,0 +1,93 @@
+#ifndef LATENCYCONTROLLER_HH
+#define LATENCYCONTROLLER_HH
+
+#include "BooleanSetting.hh"
+#include "InfoTopic.hh"
+#include "Observer.hh"
+#include "SoundLevelControl.hh"
+
+#include <cstdint>
+
+namespace openmsx {
+
+class Reactor;
+class CommandController;
+
+/** Closed-loop controller that keeps the audio and video latency low.
+  *
+  * Measurements (taken each time RealTime synchronizes, and each time the
+  * Display presents a frame):
+  * - the fill level of the sound output buffer and the number of underruns,
+  * - how far emulation runs ahead of (or lags behind) real time,
+  * - how long painting + presenting a frame takes (including the wait for
+  *   vsync) and the interval between presented frames. Note that this is
+  *   only part of the input-to-photon latency.
+  *
+  * When the 'latency_control' setting is enabled, it steers:
+  * - the emulation speed, by at most 0.5%, so that the sound buffer stays
+  *   at its target level instead of slowly drifting towards empty (clicks)
+  *   or full (extra latency and blocking in the sound driver), see
+  *   SoundLevelControl,
+  * - the target level of the sound buffer: lowered step by step while the
+  *   sound plays without underruns, raised again when an underrun occurs.
+  *   The sound driver only starts blocking a fragment above that level.
+  *
+  * The measurements are always available via 'openmsx_info latency'.
+  */
+class LatencyController final : private Observer<Setting>
+{
+public:
+	LatencyController(Reactor& reactor, CommandController& commandController);
+	~LatencyController();
+
+	/** Called by RealTime when emulation is synchronized with real time.
+	  * @param ahead How far (in us) emulation runs ahead of real time,
+	  *              negative when it lags behind.
+	  */
+	void sync(int64_t ahead);
+
+	/** Called by Display after a frame was presented.
+	  * @param duration Time (in us) it took to paint and present the frame.
+	  * @param time Timestamp (in us) at which presenting finished.
+	  */
+	void framePresented(uint64_t duration, uint64_t time);
+
+	/** Correction factor to apply on top of the 'speed' setting. */
+	[[nodiscard]] double getSpeedFactor() const { return control.getSpeedFactor(); }
+
+private:
+	void resetControl();
+
+	// Observer<Setting>
+	void update(const Setting& setting) noexcept override;
+
+private:
+	Reactor& reactor;
+	BooleanSetting enabledSetting;
+
+	struct Info final : InfoTopic {
+		explicit Info(InfoCommand& openMSXInfoCommand);
+		void execute(std::span<const TclObject> tokens,
+		             TclObject& result) const override;
+		[[nodiscard]] std::string help(std::span<const TclObject> tokens) const override;
+	} info;
+
+	// control state
+	SoundLevelControl control;
+	unsigned setpoint = 0; // in samples
+	uint64_t lastSync = 0;
+	uint64_t stableSince = 0;
+	unsigned lastUnderruns = 0;
+	bool steeringSound = false;
+
+	// measurements, smoothed, in ms
+	double aheadTime = 0.0;
+	double audioLatency = 0.0;
+	double paintTime = 0.0;
+	double frameInterval = 0.0;
+	uint64_t lastFrame = 0;
+};
+
+} // namespace openmsx
+
+#endif
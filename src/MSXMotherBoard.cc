@@ -1223,6 +1223,7 @@ void SettingObserver::update(const Setting& setting) noexcept
 // version 3: removed reRecordCount (moved to ReverseManager)
 // version 4: moved joystickportA/B from MSXPSG to here
 // version 5: do serialize renShaTurbo
+// version 6: added trainer
 template<typename Archive>
 void MSXMotherBoard::serialize(Archive& ar, unsigned version)
 {
@@ -1273,6 +1274,11 @@ void MSXMotherBoard::serialize(Archive& ar, unsigned version)
 	if (ar.versionAtLeast(version, 5)) {
 		if (renShaTurbo) ar.serialize("renShaTurbo", *renShaTurbo);
 	}
+	if (ar.versionAtLeast(version, 6)) {
+		// The rest of the debugger isn't part of the machine state, but
+		// the trainer pokes memory, so it must be replayed identically.
+		ar.serialize("trainer", getDebugger().getTrainer());
+	}
 
 	if constexpr (Archive::IS_LOADER) {
 		powered = true; // must come before changing power setting
@@ -311,7 +311,7 @@ private:
 	bool active = false;
 	bool fastForwarding = false;
 };
-SERIALIZE_CLASS_VERSION(MSXMotherBoard, 5);
+SERIALIZE_CLASS_VERSION(MSXMotherBoard, 6);
 
 class ExtCmd final : public RecordedCommand
 {
@@ -23,6 +23,7 @@
 #include "ImGuiManager.hh"
 #include "InfoTopic.hh"
 #include "InputEventGenerator.hh"
+#include "LatencyController.hh"
 #include "MSXMotherBoard.hh"
 #include "MSXPPI.hh"
 #include "MessageCommand.hh"
@@ -31,8 +32,10 @@
 #include "RTScheduler.hh"
 #include "RomDatabase.hh"
 #include "RomInfo.hh"
+#include "RomStore.hh"
 #include "StateChangeDistributor.hh"
 #include "SymbolManager.hh"
+#include "TclArgParser.hh"
 #include "TclCallbackMessages.hh"
 #include "TclObject.hh"
 #include "UserSettings.hh"
@@ -49,11 +52,15 @@
 #include "ranges.hh"
 #include "serialize.hh"
 #include "stl.hh"
+#include "strCat.hh"
+#include "xrange.hh"
 #include "unreachable.hh"
 #include "build-info.hh"
 
+#include <algorithm>
 #include <array>
 #include <cassert>
+#include <functional>
 #include <memory>
 
 using std::make_unique;
@@ -233,6 +240,8 @@ void Reactor::init()
 	symbolManager = make_unique<SymbolManager>(
 		*globalCommandController);
 	imGuiManager = make_unique<ImGuiManager>(*this, globalCommandController->getSettingsConfig());
+	latencyController = make_unique<LatencyController>(
+		*this, *globalCommandController);
 	diskFactory = make_unique<DiskFactory>(
 		*this);
 	diskManipulator = make_unique<DiskManipulator>(
@@ -240,6 +249,7 @@ void Reactor::init()
 	virtualDrive = make_unique<DiskChanger>(
 		*this, "virtual_drive");
 	filePool = make_unique<FilePool>(*globalCommandController, *this);
+	romStore = make_unique<RomStore>();
 	userSettings = make_unique<UserSettings>(
 		*globalCommandController);
 	afterCommand = make_unique<AfterCommand>(
@@ -533,10 +543,63 @@ void Reactor::enterMainLoop()
 	}
 }
 
+static std::string formatStartupTime(uint64_t us)
+{
+	auto ms = strCat(us / 1000, '.', (us / 100) % 10, " ms");
+	return strCat(spaces(std::max<size_t>(10, ms.size()) - ms.size()), ms);
+}
+
+static void printStartupProfile(
+	Reactor& reactor, const CommandLineParser& parser,
+	std::span<const std::pair<std::string_view, uint64_t>> timings)
+{
+	std::string report = "Startup profile:\n";
+	uint64_t total = 0;
+	auto add = [&](std::string_view name, uint64_t us) {
+		strAppend(report, formatStartupTime(us), "  ", name, '\n');
+		total += us;
+	};
+	for (const auto& [name, us] : parser.getStartupTimings()) add(name, us);
+	for (const auto& [name, us] : timings) {
+		add(name, us);
+		if (name != "init.tcl") continue;
+		// per script timings, collected by init.tcl itself
+		try {
+			auto list = reactor.getGlobalCommandController().executeCommand(
+				"set ::openmsx::profile_list");
+			auto& interp = reactor.getInterpreter();
+			std::vector<std::pair<uint64_t, std::string>> scripts;
+			for (auto i : xrange(list.getListLength(interp))) {
+				auto entry = list.getListIndex(interp, i);
+				scripts.emplace_back(
+					entry.getListIndex(interp, 0).getInt(interp),
+					std::string(FileOperations::getFilename(
+						entry.getListIndex(interp, 1).getString())));
+			}
+			ranges::sort(scripts, std::greater{});
+			for (const auto& [scriptUs, script] : scripts) {
+				strAppend(report, formatStartupTime(scriptUs), "      ", script, '\n');
+			}
+		} catch (MSXException&) {
+			// init.tcl didn't collect any timings, ignore
+		}
+	}
+	strAppend(report, formatStartupTime(total), "  total");
+	reactor.getCliComm().printInfo(report);
+}
+
 void Reactor::run(const CommandLineParser& parser)
 {
 	auto& commandController = *globalCommandController;
 
+	std::vector<std::pair<std::string_view, uint64_t>> timings;
+	auto time = Timer::getTime();
+	auto measure = [&](std::string_view name) {
+		auto now = Timer::getTime();
+		timings.emplace_back(name, now - time);
+		time = now;
+	};
+
 	// execute init.tcl
 	try {
 		commandController.source(
@@ -544,6 +607,7 @@ void Reactor::run(const CommandLineParser& parser)
 	} catch (FileException&) {
 		// no init.tcl, ignore
 	}
+	measure("init.tcl");
 
 	// execute startup scripts
 	for (const auto& s : parser.getStartupScripts()) {
@@ -554,6 +618,7 @@ void Reactor::run(const CommandLineParser& parser)
 			                 e.getMessage());
 		}
 	}
+	measure("startup scripts");
 	for (const auto& cmd : parser.getStartupCommands()) {
 		try {
 			commandController.executeCommand(cmd);
@@ -562,6 +627,11 @@ void Reactor::run(const CommandLineParser& parser)
 			                 '\n', e.getMessage());
 		}
 	}
+	measure("startup commands");
+
+	if (parser.isStartupProfile()) {
+		printStartupProfile(*this, parser, timings);
+	}
 
 	fullyStarted = true;
 
@@ -925,22 +995,42 @@ StoreMachineCommand::StoreMachineCommand(
 
 void StoreMachineCommand::execute(std::span<const TclObject> tokens, TclObject& result)
 {
-	checkNumArgs(tokens, 3, Prefix{1}, "id filename");
-	const auto& machineID = tokens[1].getString();
-	const auto& filename = tokens[2].getString();
+	bool binary = false;
+	std::array info = {flagArg("-binary", binary)};
+	auto arguments = parseTclArgs(getInterpreter(), tokens.subspan(1), info);
+	if (arguments.size() != 2) throw SyntaxError();
+	const auto& machineID = arguments[0].getString();
+	const auto& filename = arguments[1].getString();
 
 	auto& board = *reactor.getMachine(machineID);
 
-	XmlOutputArchive out(filename);
-	out.serialize("machine", board);
-	out.close();
+	if (binary) {
+		MemOutputArchive out;
+		out.serialize("machine", board);
+		size_t size;
+		auto buf = out.releaseBuffer(size);
+		try {
+			writeBinarySaveState(string(filename), std::span{buf.data(), size});
+		} catch (MSXException& e) {
+			throw CommandException("Cannot save state: ", e.getMessage());
+		}
+	} else {
+		XmlOutputArchive out(filename);
+		out.serialize("machine", board);
+		out.close();
+	}
 	result = filename;
 }
 
 string StoreMachineCommand::help(std::span<const TclObject> /*tokens*/) const
 {
 	return
-		"store_machine machineID <filename>  Save state of machine \"machineID\" to indicated file\n"
+		"store_machine [-binary] machineID <filename>  Save state of machine \"machineID\" to indicated file\n"
+		"\n"
+		"By default the state is stored as (compressed) XML. With -binary a more\n"
+		"compact format is used which is also a lot faster to save and load, but\n"
+		"which can only be loaded on the same type of platform (e.g. 64-bit little\n"
+		"endian) on which it was created. 'restore_machine' handles both formats.\n"
 		"\n"
 		"This is a low-level command, the 'savestate' script is easier to use.";
 }
@@ -969,13 +1059,23 @@ void RestoreMachineCommand::execute(std::span<const TclObject> tokens,
 	const auto filename = FileOperations::expandTilde(string(tokens[1].getString()));
 
 	try {
-		XmlInputArchive in(filename);
-		in.serialize("machine", *newBoard);
+		if (isBinarySaveState(filename)) {
+			size_t size;
+			auto buf = readBinarySaveState(filename, size);
+			MemInputArchive in(std::span{buf.data(), size});
+			in.serialize("machine", *newBoard);
+		} else {
+			XmlInputArchive in(filename);
+			in.serialize("machine", *newBoard);
+		}
 	} catch (XMLException& e) {
 		throw CommandException("Cannot load state, bad file format: ",
 		                       e.getMessage());
 	} catch (MSXException& e) {
 		throw CommandException("Cannot load state: ", e.getMessage());
+	} catch (std::bad_alloc&) {
+		throw CommandException("Cannot load state: not enough memory "
+		                       "(corrupt savestate?)");
 	}
 
 	// Savestate also contains stuff like the keyboard state at the moment
@@ -29,10 +29,12 @@ class Interpreter;
 class Display;
 class Mixer;
 class InputEventGenerator;
+class LatencyController;
 class DiskFactory;
 class DiskManipulator;
 class DiskChanger;
 class FilePool;
+class RomStore;
 class HotKey;
 class UserSettings;
 class RomDatabase;
@@ -91,10 +93,12 @@ public:
 	[[nodiscard]] InputEventGenerator& getInputEventGenerator() { return *inputEventGenerator; }
 	[[nodiscard]] Display& getDisplay() { assert(display); return *display; }
 	[[nodiscard]] Mixer& getMixer();
+	[[nodiscard]] LatencyController& getLatencyController() { return *latencyController; }
 	[[nodiscard]] DiskFactory& getDiskFactory() { return *diskFactory; }
 	[[nodiscard]] DiskManipulator& getDiskManipulator() { return *diskManipulator; }
 	[[nodiscard]] EnumSetting<int>& getMachineSetting() { return *machineSetting; }
 	[[nodiscard]] FilePool& getFilePool() { return *filePool; }
+	[[nodiscard]] RomStore& getRomStore() { return *romStore; }
 	[[nodiscard]] ImGuiManager& getImGuiManager() { return *imGuiManager; }
 	[[nodiscard]] const HotKey& getHotKey() const;
 	[[nodiscard]] SymbolManager& getSymbolManager() const { return *symbolManager; }
@@ -164,12 +168,14 @@ private:
 	std::unique_ptr<InputEventGenerator> inputEventGenerator;
 	std::unique_ptr<SymbolManager> symbolManager; // before imGuiManager
 	std::unique_ptr<ImGuiManager> imGuiManager; // before display
+	std::unique_ptr<LatencyController> latencyController; // before display
 	std::unique_ptr<Display> display;
 	std::unique_ptr<Mixer> mixer; // lazy initialized
 	std::unique_ptr<DiskFactory> diskFactory;
 	std::unique_ptr<DiskManipulator> diskManipulator;
 	std::unique_ptr<DiskChanger> virtualDrive;
 	std::unique_ptr<FilePool> filePool;
+	std::unique_ptr<RomStore> romStore;
 
 	std::unique_ptr<EnumSetting<int>> machineSetting;
 	std::unique_ptr<UserSettings> userSettings;
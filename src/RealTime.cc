@@ -5,6 +5,7 @@
 #include "EventDelay.hh"
 #include "EventDistributor.hh"
 #include "GlobalSettings.hh"
+#include "LatencyController.hh"
 #include "MSXMotherBoard.hh"
 #include "Reactor.hh"
 #include "ThrottleManager.hh"
@@ -28,6 +29,7 @@ RealTime::RealTime(
 	, eventDelay(eventDelay_)
 	, speedManager   (globalSettings.getSpeedManager())
 	, throttleManager(globalSettings.getThrottleManager())
+	, latencyController(motherBoard.getReactor().getLatencyController())
 	, pauseSetting   (globalSettings.getPauseSetting())
 	, powerSetting   (globalSettings.getPowerSetting())
 {
@@ -54,14 +56,19 @@ RealTime::~RealTime()
 	speedManager.detach(*this);
 }
 
+double RealTime::getSpeed() const
+{
+	return speedManager.getSpeed() * latencyController.getSpeedFactor();
+}
+
 double RealTime::getRealDuration(EmuTime::param time1, EmuTime::param time2) const
 {
-	return (time2 - time1).toDouble() / speedManager.getSpeed();
+	return (time2 - time1).toDouble() / getSpeed();
 }
 
 EmuDuration RealTime::getEmuDuration(double realDur) const
 {
-	return EmuDuration(realDur * speedManager.getSpeed());
+	return EmuDuration(realDur * getSpeed());
 }
 
 bool RealTime::timeLeft(uint64_t us, EmuTime::param time) const
@@ -93,6 +100,7 @@ void RealTime::internalSync(EmuTime::param time, bool allowSleep)
 		auto currentRealTime = Timer::getTime();
 		auto sleep = narrow_cast<int64_t>(idealRealTime - currentRealTime);
 		if (allowSleep) {
+			latencyController.sync(sleep);
 			// want to sleep for 'sleep' us
 			sleep += narrow_cast<int64_t>(sleepAdjust);
 			int64_t delta = 0;
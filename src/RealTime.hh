@@ -14,6 +14,7 @@ class MSXMotherBoard;
 class GlobalSettings;
 class EventDistributor;
 class EventDelay;
+class LatencyController;
 class BooleanSetting;
 class SpeedManager;
 class ThrottleManager;
@@ -72,12 +73,14 @@ private:
 	void update(const ThrottleManager& throttleManager) noexcept override;
 
 	void internalSync(EmuTime::param time, bool allowSleep);
+	[[nodiscard]] double getSpeed() const;
 
 	MSXMotherBoard& motherBoard;
 	EventDistributor& eventDistributor;
 	EventDelay& eventDelay;
 	SpeedManager& speedManager;
 	ThrottleManager& throttleManager;
+	LatencyController& latencyController;
 	BooleanSetting& pauseSetting;
 	BooleanSetting& powerSetting;
 
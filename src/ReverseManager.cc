@@ -8,6 +8,9 @@
 #include "EventDelay.hh"
 #include "MSXMixer.hh"
 #include "MSXCommandController.hh"
+#include "RecordedCommand.hh"
+#include "RunAhead.hh"
+#include "VDP.hh"
 #include "XMLException.hh"
 #include "TclArgParser.hh"
 #include "TclObject.hh"
@@ -26,6 +29,8 @@
 #include "serialize.hh"
 #include "serialize_meta.hh"
 #include "view.hh"
+#include "xrange.hh"
+#include <algorithm>
 #include <array>
 #include <cassert>
 #include <cmath>
@@ -134,6 +139,7 @@ REGISTER_POLYMORPHIC_CLASS(StateChange, EndLogEvent, "EndLog");
 ReverseManager::ReverseManager(MSXMotherBoard& motherBoard_)
 	: syncNewSnapshot(motherBoard_.getScheduler())
 	, syncInputEvent (motherBoard_.getScheduler())
+	, syncFrameSnapshot(motherBoard_.getScheduler())
 	, motherBoard(motherBoard_)
 	, eventDistributor(motherBoard.getReactor().getEventDistributor())
 	, reverseCmd(motherBoard.getCommandController())
@@ -165,6 +171,7 @@ void ReverseManager::start()
 		schedule(getCurrentTime());
 		// start recording events
 		motherBoard.getStateChangeDistributor().registerRecorder(*this);
+		runAheadIndex = history.events.size();
 	}
 	assert(isCollecting());
 }
@@ -175,10 +182,16 @@ void ReverseManager::stop()
 		motherBoard.getStateChangeDistributor().unregisterRecorder(*this);
 		syncNewSnapshot.removeSyncPoint(); // don't schedule new snapshot takings
 		syncInputEvent .removeSyncPoint(); // stop any pending replay actions
+		syncFrameSnapshot.removeSyncPoint();
 		history.clear();
+		frameChunks.clear();
+		frameDeltaBlocks.clear();
 		replayIndex = 0;
+		runAheadIndex = 0;
 		collecting = false;
 		pendingTakeSnapshot = false;
+		pendingFrameSnapshot = false;
+		pendingRunAhead = false;
 	}
 	assert(!pendingTakeSnapshot);
 	assert(!isCollecting());
@@ -403,42 +416,8 @@ void ReverseManager::goTo(
 		} else {
 			// Note: we don't (anymore) erase future snapshots
 			// -- restore old snapshot --
-			newBoard_ = reactor.createEmptyMotherBoard();
+			newBoard_ = restoreSnapshot(chunk, hist, currentTime);
 			newBoard = newBoard_.get();
-			// suppress messages we'd get by deserializing (and
-			// thus instantiating the parts of) the new board
-			newBoard->getMSXCliComm().setSuppressMessages(true);
-			MemInputArchive in(chunk.savestate.data(),
-					   chunk.size,
-					   chunk.deltaBlocks);
-			in.serialize("machine", *newBoard);
-
-			if (eventDelay) {
-				// Handle all events that are scheduled, but not yet
-				// distributed. This makes sure no events get lost
-				// (important to keep host/msx keyboard in sync).
-				eventDelay->flush();
-			}
-
-			// terminate replay log with EndLogEvent (if not there already)
-			if (hist.events.empty() ||
-			    !dynamic_cast<const EndLogEvent*>(hist.events.back().get())) {
-				hist.events.push_back(
-					std::make_unique<EndLogEvent>(currentTime));
-			}
-
-			// Transfer history to the new ReverseManager.
-			// Also we should stop collecting in this ReverseManager,
-			// and start collecting in the new one.
-			auto& newManager = newBoard->getReverseManager();
-			newManager.transferHistory(hist, chunk.eventCount);
-
-			// transfer (or copy) state from old to new machine
-			transferState(*newBoard);
-
-			// In case of load-replay it's possible we are not collecting,
-			// but calling stop() anyway is ok.
-			stop();
 		}
 
 		// -- goto correct time within snapshot --
@@ -516,6 +495,47 @@ void ReverseManager::goTo(
 	}
 }
 
+Reactor::Board ReverseManager::restoreSnapshot(
+	const ReverseChunk& chunk, ReverseHistory& hist, EmuTime::param currentTime)
+{
+	auto newBoard = motherBoard.getReactor().createEmptyMotherBoard();
+	// suppress messages we'd get by deserializing (and
+	// thus instantiating the parts of) the new board
+	newBoard->getMSXCliComm().setSuppressMessages(true);
+	MemInputArchive in(chunk.savestate.data(),
+	                   chunk.size,
+	                   chunk.deltaBlocks);
+	in.serialize("machine", *newBoard);
+
+	if (eventDelay) {
+		// Handle all events that are scheduled, but not yet
+		// distributed. This makes sure no events get lost
+		// (important to keep host/msx keyboard in sync).
+		eventDelay->flush();
+	}
+
+	// terminate replay log with EndLogEvent (if not there already)
+	if (hist.events.empty() ||
+	    !dynamic_cast<const EndLogEvent*>(hist.events.back().get())) {
+		hist.events.push_back(
+			std::make_unique<EndLogEvent>(currentTime));
+	}
+
+	// Transfer history to the new ReverseManager.
+	// Also we should stop collecting in this ReverseManager,
+	// and start collecting in the new one.
+	auto& newManager = newBoard->getReverseManager();
+	newManager.transferHistory(hist, chunk.eventCount);
+
+	// transfer (or copy) state from old to new machine
+	transferState(*newBoard);
+
+	// In case of load-replay it's possible we are not collecting,
+	// but calling stop() anyway is ok.
+	stop();
+	return newBoard;
+}
+
 void ReverseManager::transferState(MSXMotherBoard& newBoard)
 {
 	// Transfer view only mode
@@ -535,6 +555,9 @@ void ReverseManager::transferState(MSXMotherBoard& newBoard)
 	// copy rerecord count
 	newManager.reRecordCount = reRecordCount;
 
+	// (re)start taking frame snapshots in the new machine
+	newManager.setRunAhead(runAheadFrames);
+
 	// transfer settings
 	const auto& oldController = motherBoard.getMSXCommandController();
 	newBoard.getMSXCommandController().transferSettings(oldController);
@@ -849,6 +872,15 @@ int ReverseManager::signalEvent(const Event& event)
 		// schedule creation of next snapshot
 		schedule(getCurrentTime());
 	}
+	if (pendingFrameSnapshot) {
+		pendingFrameSnapshot = false;
+		takeFrameSnapshot(getCurrentTime());
+		scheduleFrameSnapshot(getCurrentTime());
+	}
+	if (pendingRunAhead) {
+		pendingRunAhead = false;
+		runAhead(); // note: this may delete this object
+	}
 	return 0;
 }
 
@@ -912,6 +944,7 @@ void ReverseManager::stopReplay(EmuTime::param time) noexcept
 			return p.second.time > time;
 		});
 		history.chunks.erase(it, end(history.chunks));
+		runAheadIndex = std::min(runAheadIndex, events.size());
 		// this also means someone is changing history, record that
 		reRecordCount++;
 	}
@@ -951,6 +984,175 @@ void ReverseManager::schedule(EmuTime::param time)
 }
 
 
+// run-ahead
+
+void ReverseManager::setRunAhead(unsigned frames)
+{
+	runAheadFrames = frames;
+	syncFrameSnapshot.removeSyncPoint();
+	frameChunks.clear();
+	frameDeltaBlocks.clear();
+	if (!frames) return;
+
+	start(); // run-ahead works on the recorded events
+	// Don't move events that were recorded before run-ahead got enabled,
+	// nor events that are still going to be replayed.
+	auto num = history.events.size();
+	if (num && dynamic_cast<const EndLogEvent*>(history.events.back().get())) {
+		--num;
+	}
+	runAheadIndex = num;
+	scheduleFrameSnapshot(getCurrentTime());
+}
+
+EmuDuration ReverseManager::getFrameDuration() const
+{
+	if (auto* vdp = dynamic_cast<VDP*>(motherBoard.findDevice("VDP"))) {
+		return VDP::VDPClock::duration(vdp->getTicksPerFrame());
+	}
+	return EmuDuration::hz(60);
+}
+
+void ReverseManager::scheduleFrameSnapshot(EmuTime::param time)
+{
+	syncFrameSnapshot.setSyncPoint(time + getFrameDuration());
+}
+
+void ReverseManager::execFrameSnapshot()
+{
+	// See execNewSnapshot() for why this goes via an event.
+	pendingFrameSnapshot = true;
+	eventDistributor.distributeEvent(TakeReverseSnapshotEvent());
+}
+
+void ReverseManager::takeFrameSnapshot(EmuTime::param time)
+{
+	// To move an event 'runAheadFrames' frames back, we need a snapshot
+	// at least that old. Keep one extra because the snapshots are not
+	// exactly aligned with the frames.
+	while (frameChunks.size() > runAheadFrames + 1) {
+		frameChunks.pop_front();
+	}
+	auto& chunk = frameChunks.emplace_back();
+	MemOutputArchive out(frameDeltaBlocks, chunk.deltaBlocks, true);
+	out.serialize("machine", motherBoard);
+	chunk.time = time;
+	chunk.savestate = out.releaseBuffer(chunk.size);
+	chunk.eventCount = replayIndex;
+}
+
+void ReverseManager::scheduleRunAhead()
+{
+	// Can't restore a snapshot in the middle of recording an event, so
+	// handle it later, see execNewSnapshot() for more details.
+	if (!pendingRunAhead) {
+		pendingRunAhead = true;
+		eventDistributor.distributeEvent(TakeReverseSnapshotEvent());
+	}
+}
+
+/* Games typically only react to input one or more frames after it was
+ * given (e.g. they read the joystick during one frame, and only show the
+ * result during the next). Run-ahead hides that delay by pretending the
+ * input was given 'runAheadFrames' frames earlier:
+ *  - the new input events in the history are moved into the past,
+ *  - the machine is restored from the frame snapshot before that moment,
+ *  - the replay mechanism then re-emulates up to the present (including
+ *    the moved events), only the last frame is rendered.
+ * Without new input the emulation is deterministic, so then there's
+ * nothing to do: we already show what the machine would show with
+ * run-ahead. This means the (relatively expensive) restore only happens
+ * when the input changes, not twice per frame.
+ */
+void ReverseManager::runAhead()
+{
+	auto& events = history.events;
+	if (!isCollecting() || isReplaying() || (runAheadIndex >= events.size())) return;
+
+	// Only move input events, recorded commands stay where they are.
+	auto isInput = [](const StateChange& e) {
+		return !dynamic_cast<const MSXCommandEvent*>(&e) &&
+		       !dynamic_cast<const EndLogEvent*>(&e);
+	};
+	auto first = std::find_if(begin(events) + narrow<ptrdiff_t>(runAheadIndex), end(events),
+	                          [&](const auto& e) { return isInput(*e); });
+	if (first == end(events)) {
+		runAheadIndex = events.size();
+		return;
+	}
+	auto firstInput = narrow<size_t>(first - begin(events));
+
+	auto shift = getFrameDuration() * runAheadFrames;
+	auto num = RunAhead::selectSnapshot(
+		frameChunks, runAheadIndex, RunAhead::earlier((*first)->getTime(), shift));
+	if (num == 0) {
+		runAheadIndex = events.size();
+		return;
+	}
+	auto moveFrom = runAheadIndex;
+
+	// restoreSnapshot() stops this ReverseManager, which drops the frame
+	// snapshots. Take them out first, so that the ones that remain valid
+	// can be handed to the new ReverseManager.
+	std::deque<ReverseChunk> frames;
+	std::swap(frames, frameChunks);
+	const auto& chunk = frames[num - 1];
+	auto snapshotTime = chunk.time;
+
+	auto& reactor = motherBoard.getReactor();
+	auto& mixer = motherBoard.getMSXMixer();
+	bool restored = false;
+	try {
+		mixer.mute(); // see goTo()
+		auto now = getCurrentTime();
+		auto frame = getFrameDuration();
+		// Restore before changing the history: when this fails, the
+		// history (and this machine) is left untouched.
+		auto newBoard_ = restoreSnapshot(chunk, history, now);
+		auto* newBoard = newBoard_.get();
+		restored = true;
+
+		// From here on the history belongs to the new ReverseManager.
+		auto& newManager = newBoard->getReverseManager();
+		auto& hist = newManager.history;
+		RunAhead::moveEvents(hist.events, moveFrom, snapshotTime, shift, isInput);
+		// The (long-term) snapshots that are newer than the earliest
+		// moved event don't match the new time-line anymore (they were
+		// taken before that event was executed), erase them (like in
+		// stopReplay()).
+		RunAhead::eraseNewerSnapshots(hist.chunks, hist.events[firstInput]->getTime());
+		// The next event to replay may have moved.
+		newManager.syncInputEvent.removeSyncPoint();
+		newManager.replayNextEvent();
+		// These frame snapshots remain valid in the new time-line.
+		newManager.frameChunks.assign(
+			std::make_move_iterator(begin(frames)),
+			std::make_move_iterator(begin(frames) + narrow<ptrdiff_t>(num)));
+		// this also means someone is changing history, record that
+		++newManager.reRecordCount;
+
+		// Re-emulate, only render the last frame.
+		auto preTarget = ((now - snapshotTime) > frame) ? (now - frame) : snapshotTime;
+		newBoard->fastForward(preTarget, true);
+		newBoard->getMSXCliComm().setSuppressMessages(false);
+
+		// Note: this deletes the current MSXMotherBoard and
+		// ReverseManager. So we can't access those objects anymore.
+		reactor.replaceBoard(motherBoard, std::move(newBoard_));
+		newBoard->fastForward(now, false);
+	} catch (MSXException& e) {
+		if (!restored) {
+			// Nothing changed yet, keep the frame snapshots.
+			std::swap(frames, frameChunks);
+		}
+		// Make sure mixer doesn't stay muted in case of error.
+		mixer.unmute();
+		// We're called from an event handler, so don't propagate.
+		reactor.getCliComm().printWarning("Run-ahead failed: ", e.getMessage());
+	}
+}
+
+
 // class ReverseCmd
 
 ReverseManager::ReverseCmd::ReverseCmd(CommandController& controller)
@@ -987,6 +1189,22 @@ void ReverseManager::ReverseCmd::execute(std::span<const TclObject> tokens, TclO
 		"truncatereplay", [&] {
 			if (manager.isReplaying()) {
 				manager.signalStopReplay(manager.getCurrentTime());
+			}},
+		"runahead", [&]{
+			switch (tokens.size()) {
+			case 2:
+				result = narrow<int>(manager.getRunAhead());
+				break;
+			case 3: {
+				auto frames = tokens[2].getInt(interp);
+				if ((frames < 0) || (frames > 10)) {
+					throw CommandException("Number of frames must be between 0 and 10");
+				}
+				manager.setRunAhead(unsigned(frames));
+				break;
+			}
+			default:
+				throw SyntaxError();
 			}});
 }
 
@@ -999,6 +1217,7 @@ std::string ReverseManager::ReverseCmd::help(std::span<const TclObject> /*tokens
 	       "goto <time>         go to an absolute moment in time\n"
 	       "viewonlymode <bool> switch viewonly mode on or off\n"
 	       "truncatereplay      stop replaying and remove all 'future' data\n"
+	       "runahead [<n>]      show or set run-ahead: input takes effect <n> frames earlier (0 = off)\n"
 	       "savereplay [<name>] save the first snapshot and all replay data as a 'replay' (with optional name)\n"
 	       "loadreplay [-goto <begin|end|savetime|<n>>] [-viewonly] <name>   load a replay (snapshot and replay data) with given name and start replaying\n";
 }
@@ -1010,7 +1229,7 @@ void ReverseManager::ReverseCmd::tabCompletion(std::vector<std::string>& tokens)
 		static constexpr std::array subCommands = {
 			"start"sv, "stop"sv, "status"sv, "goback"sv, "goto"sv,
 			"savereplay"sv, "loadreplay"sv, "viewonlymode"sv,
-			"truncatereplay"sv,
+			"truncatereplay"sv, "runahead"sv,
 		};
 		completeString(tokens, subCommands);
 	} else if ((tokens.size() == 3) || (tokens[1] == "loadreplay")) {
@@ -64,6 +64,7 @@ public:
 		assert(!isReplaying());
 		++replayIndex;
 		history.events.push_back(std::make_unique<T>(time, std::forward<Args>(args)...));
+		if (runAheadFrames) scheduleRunAhead();
 		return *history.events.back();
 	}
 
@@ -74,6 +75,11 @@ public:
 	[[nodiscard]] double getCurrent() const;
 	[[nodiscard]] std::vector<double> getSnapshotTimes() const;
 
+	/** Run-ahead: new input events are moved this many frames into the
+	  * past (0 = disabled). See runAhead() for details. */
+	[[nodiscard]] unsigned getRunAhead() const { return runAheadFrames; }
+	void setRunAhead(unsigned frames);
+
 private:
 	struct ReverseChunk {
 		EmuTime time = EmuTime::zero();
@@ -118,7 +124,14 @@ private:
 	void transferHistory(ReverseHistory& oldHistory,
 	                     unsigned oldEventCount);
 	void transferState(MSXMotherBoard& newBoard);
+	[[nodiscard]] std::shared_ptr<MSXMotherBoard> restoreSnapshot(
+		const ReverseChunk& chunk, ReverseHistory& hist, EmuTime::param currentTime);
 	void takeSnapshot(EmuTime::param time);
+	void takeFrameSnapshot(EmuTime::param time);
+	void scheduleFrameSnapshot(EmuTime::param time);
+	[[nodiscard]] EmuDuration getFrameDuration() const;
+	void scheduleRunAhead();
+	void runAhead();
 	void schedule(EmuTime::param time);
 	void replayNextEvent();
 	template<unsigned N> void dropOldSnapshots(unsigned count);
@@ -141,7 +154,17 @@ private:
 		}
 	} syncInputEvent;
 
+	struct SyncFrameSnapshot final : Schedulable {
+		friend class ReverseManager;
+		explicit SyncFrameSnapshot(Scheduler& s) : Schedulable(s) {}
+		void executeUntil(EmuTime::param /*time*/) override {
+			auto& rm = OUTER(ReverseManager, syncFrameSnapshot);
+			rm.execFrameSnapshot();
+		}
+	} syncFrameSnapshot;
+
 	void execNewSnapshot();
+	void execFrameSnapshot();
 	void execInputEvent();
 	[[nodiscard]] EmuTime::param getCurrentTime() const { return syncNewSnapshot.getCurrentTime(); }
 
@@ -166,6 +189,14 @@ private:
 	bool collecting = false;
 	bool pendingTakeSnapshot = false;
 
+	// run-ahead
+	std::deque<ReverseChunk> frameChunks; // one per frame, oldest first
+	LastDeltaBlocks frameDeltaBlocks;
+	unsigned runAheadFrames = 0;
+	size_t runAheadIndex = 0; // first event that wasn't moved into the past yet
+	bool pendingFrameSnapshot = false;
+	bool pendingRunAhead = false;
+
 	unsigned reRecordCount = 0;
 
 	friend struct Replay;
@@ -0,0 +1,80 @@
+#ifndef RUNAHEAD_HH
+#define RUNAHEAD_HH
+
+#include "EmuDuration.hh"
+#include "EmuTime.hh"
+
+#include "ranges.hh"
+#include "xrange.hh"
+
+#include <algorithm>
+#include <cstddef>
+#include <iterator>
+
+namespace openmsx::RunAhead {
+
+/** The history manipulations done by ReverseManager::runAhead(). They're
+  * templatized on the event and snapshot containers, so that the unittest
+  * can run them without a machine. Events must offer getTime() and
+  * setTime(), snapshots must have 'time' and 'eventCount' members.
+  */
+
+/** The moment 'shift' before 'time', but not before the start of time. */
+[[nodiscard]] inline EmuTime earlier(EmuTime::param time, EmuDuration::param shift)
+{
+	return ((time - EmuTime::zero()) > shift) ? (time - shift) : EmuTime::zero();
+}
+
+/** Select the frame snapshot to restore to replay an event at 'eventTime'
+  * as if it happened at 'wanted': the newest one that is old enough.
+  * Snapshots taken after event 'firstEvent' was recorded can't be used. If
+  * none is old enough, the oldest one is used (the events are then moved
+  * back as far as possible).
+  * @return The number of (oldest) frame snapshots that remain valid in the
+  *         new time-line, the last of these is the one to restore. Zero when
+  *         none can be used.
+  */
+template<typename FrameChunks>
+[[nodiscard]] size_t selectSnapshot(const FrameChunks& frameChunks, size_t firstEvent,
+                                    EmuTime::param wanted)
+{
+	size_t num = 0;
+	for (const auto& chunk : frameChunks) {
+		if (chunk.eventCount > firstEvent) break;
+		if (num && (chunk.time > wanted)) break;
+		++num;
+	}
+	return num;
+}
+
+/** Move the events starting at 'first' 'shift' into the past, but not before
+  * 'snapshotTime' (the moment of the restored snapshot) nor before the
+  * preceding event, so that they remain sorted. Events for which
+  * 'isMovable' returns false stay where they are.
+  */
+template<typename Events, typename Pred>
+void moveEvents(Events& events, size_t first, EmuTime::param snapshotTime,
+                EmuDuration::param shift, Pred isMovable)
+{
+	auto prev = first ? std::max(snapshotTime, events[first - 1]->getTime())
+	                  : snapshotTime;
+	for (auto i : xrange(first, events.size())) {
+		auto& e = *events[i];
+		if (isMovable(e)) e.setTime(std::max(earlier(e.getTime(), shift), prev));
+		prev = e.getTime();
+	}
+}
+
+/** Erase the (long-term) snapshots that are newer than 'time'. */
+template<typename Chunks>
+void eraseNewerSnapshots(Chunks& chunks, EmuTime::param time)
+{
+	auto it = ranges::find_if(chunks, [&](auto& p) {
+		return p.second.time > time;
+	});
+	chunks.erase(it, std::end(chunks));
+}
+
+} // namespace openmsx::RunAhead
+
+#endif
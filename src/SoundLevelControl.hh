@@ -0,0 +1,69 @@
+#ifndef SOUNDLEVELCONTROL_HH
+#define SOUNDLEVELCONTROL_HH
+
+#include <algorithm>
+
+namespace openmsx {
+
+/** PI-controller that keeps the fill level of the sound output buffer at a
+  * setpoint by correcting the emulation speed by a tiny amount: too much
+  * buffered means emulation runs ahead of the sound device, so slow down a
+  * little (and vice versa).
+  *
+  * The sound driver blocks emulation when the buffer would rise above its
+  * pacing limit. The setpoint must stay clearly below that limit (see
+  * getPacingLimit()), otherwise the measured level can never be above the
+  * setpoint and the integral only winds up in one direction.
+  *
+  * This class only contains the math (no dependencies on the rest of
+  * openMSX), so that it can be tested in isolation.
+  */
+class SoundLevelControl
+{
+public:
+	static constexpr double MAX_CORRECTION = 0.005; // at most 0.5% faster or slower
+	// Closed loop: natural frequency 0.3 rad/s, damping 0.7.
+	static constexpr double KP = 0.42; // per second of sound buffer error
+	static constexpr double KI = 0.09; // per second of accumulated error, per second
+	// The level jumps up at every upload and down at every fragment the
+	// sound device takes, filter that out before steering on it.
+	static constexpr double FILTER_TIME = 1.0; // in s
+
+	/** The level at which the sound driver should start blocking, for the
+	  * given setpoint. One fragment of headroom: pacing only kicks in when
+	  * emulation runs ahead by more than that.
+	  */
+	[[nodiscard]] static constexpr unsigned getPacingLimit(unsigned setpoint, unsigned fragment) {
+		return setpoint + fragment;
+	}
+
+	/** Feed a new measurement.
+	  * @param error Buffered sound minus the setpoint (in s).
+	  * @param dt Time since the previous measurement (in s).
+	  */
+	void update(double error, double dt) {
+		filtered += (error - filtered) * std::min(1.0, dt / FILTER_TIME);
+		integral = std::clamp(integral + filtered * dt,
+		                      -MAX_CORRECTION / KI, MAX_CORRECTION / KI);
+		speedFactor = 1.0 - std::clamp(KP * filtered + KI * integral,
+		                               -MAX_CORRECTION, MAX_CORRECTION);
+	}
+
+	void reset() {
+		speedFactor = 1.0;
+		integral = 0.0;
+		filtered = 0.0;
+	}
+
+	/** Correction factor to apply on top of the 'speed' setting. */
+	[[nodiscard]] double getSpeedFactor() const { return speedFactor; }
+
+private:
+	double speedFactor = 1.0;
+	double integral = 0.0; // of the filtered error, in s*s
+	double filtered = 0.0; // in s
+};
+
+} // namespace openmsx
+
+#endif
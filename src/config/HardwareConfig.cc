@@ -12,8 +12,11 @@
 #include "serialize.hh"
 #include "serialize_stl.hh"
 
+#include "hash_map.hh"
+#include "stl.hh"
 #include "unreachable.hh"
 #include "xrange.hh"
+#include "xxhash.hh"
 
 #include <array>
 #include <cassert>
@@ -267,15 +270,54 @@ static std::string getFilename(std::string_view type, std::string_view name)
 	}
 }
 
+// Parsing (and validating) the XML file is a significant part of the time it
+// takes to create a machine or extension. Keep the parsed documents of the
+// instantiated configs around, so that instantiating the same config again
+// only needs a (cheap) in-memory copy. The cache is keyed on the resolved
+// filename (resolving is cheap compared to parsing), so a new file that shadows
+// the cached one in an earlier search directory is picked up. A file that's
+// modified while openMSX is running is detected via its modification time.
+struct CachedConfig {
+	time_t modificationTime;
+	XMLDocument doc{8192};
+};
+static hash_map<std::string, std::unique_ptr<CachedConfig>, XXHasher> configCache;
+
+static time_t getModificationTime(const std::string& filename)
+{
+	auto st = FileOperations::getStat(filename);
+	return st ? FileOperations::getModificationDate(*st) : time_t(-1);
+}
+
+static const CachedConfig& getCachedConfig(const std::string& filename)
+{
+	auto mtime = getModificationTime(filename);
+	if (auto* cached = lookup(configCache, filename)) {
+		auto& entry = **cached;
+		if (mtime == entry.modificationTime) {
+			return entry;
+		}
+		configCache.erase(filename);
+	}
+	auto entry = std::make_unique<CachedConfig>();
+	entry->modificationTime = mtime;
+	loadHelper(entry->doc, filename);
+	auto [it, inserted] = configCache.emplace(filename, std::move(entry));
+	assert(inserted);
+	return *it->second;
+}
+
 void HardwareConfig::loadConfig(XMLDocument& doc, std::string_view type, std::string_view name)
 {
+	// Not cached: this is used to query the meta info of all available
+	// configs, most of which are never instantiated.
 	loadHelper(doc, getFilename(type, name));
 }
 
 void HardwareConfig::load(std::string_view type_)
 {
-	std::string filename = getFilename(type_, hwName);
-	loadHelper(config, filename);
+	auto filename = getFilename(type_, hwName);
+	config.copy(getCachedConfig(filename).doc);
 
 	assert(!userName.empty());
 	const auto& dirname = FileOperations::getDirName(filename);
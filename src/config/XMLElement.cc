@@ -514,6 +514,12 @@ void XMLDocument::load(const OldXMLElement& elem)
 	root = clone(elem);
 }
 
+void XMLDocument::copy(const XMLDocument& other)
+{
+	assert(!root);
+	if (other.root) root = clone(*other.root);
+}
+
 
 static std::unique_ptr<FileContext> lastSerializedFileContext;
 std::unique_ptr<FileContext> OldXMLElement::getLastSerializedFileContext()
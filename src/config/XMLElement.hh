@@ -313,6 +313,10 @@ public:
 
 	void load(const OldXMLElement& elem); // bw compat
 
+	// Deep-copy the content of another document. Requires that this
+	// document is still empty.
+	void copy(const XMLDocument& other);
+
 	void serialize(MemInputArchive&  ar, unsigned version);
 	void serialize(MemOutputArchive& ar, unsigned version) const;
 	void serialize(XmlInputArchive&  ar, unsigned version);
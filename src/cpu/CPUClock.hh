@@ -58,6 +58,11 @@ protected:
 		return halts;
 	}
 
+	/** Number of cycles that can still be executed before the limit is
+	  * reached. Negative when the limit is reached or disabled.
+	  */
+	[[nodiscard]] int getRemaining() const { return remaining; }
+
 	/** R800 runs at 7MHz, but I/O is done over a slower 3.5MHz bus. So
 	  * sometimes right before I/O it's needed to wait for one cycle so
 	  * that we're at the start of a clock cycle of the slower bus.
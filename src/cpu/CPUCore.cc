@@ -160,6 +160,8 @@
 
 #include "CPUCore.hh"
 
+#include "CPUTraceBuffer.hh"
+#include "HeatMap.hh"
 #include "MSXCPUInterface.hh"
 #include "Scheduler.hh"
 #include "MSXMotherBoard.hh"
@@ -281,6 +283,10 @@ static constexpr Table table = initTables();
 // the (logical) lifetime of this variable cannot overlap between execution
 // of two MSX machines.
 static word start_pc;
+// Same for the opcode bytes at 'start_pc', read before the instruction
+// executes (only when recording into the cputrace buffer).
+static std::array<byte, 4> start_opcode;
+static uint8_t start_length;
 
 // conditions
 struct CondC  { bool operator()(byte f) const { return  (f & C_FLAG) != 0; } };
@@ -295,13 +301,15 @@ struct CondTrue { bool operator()(byte /*f*/) const { return true; } };
 
 template<typename T> CPUCore<T>::CPUCore(
 		MSXMotherBoard& motherboard_, const std::string& name,
-		const BooleanSetting& traceSetting_,
-		TclCallback& diHaltCallback_, EmuTime::param time)
+		const BooleanSetting& traceSetting_, CPUTraceBuffer& traceBuffer_,
+		HeatMap& heatMap_, TclCallback& diHaltCallback_, EmuTime::param time)
 	: CPURegs(T::IS_R800)
 	, T(time, motherboard_.getScheduler())
 	, motherboard(motherboard_)
 	, scheduler(motherboard.getScheduler())
 	, traceSetting(traceSetting_)
+	, traceBuffer(traceBuffer_)
+	, heatMap(heatMap_)
 	, diHaltCallback(diHaltCallback_)
 	, IRQStatus(motherboard.getDebugger(), name + ".pendingIRQ",
 	            "Non-zero if there are pending IRQs (thus CPU would enter "
@@ -320,11 +328,12 @@ template<typename T> CPUCore<T>::CPUCore(
 		"custom CPU frequency (only valid when unlocked)",
 		T::CLOCK_FREQ, 1000000, 1000000000)
 	, freq(T::CLOCK_FREQ)
-	, tracingEnabled(traceSetting.getBoolean())
+	, tracingEnabled(false)
 	, isCMOS(motherboard.hasToshibaEngine())  // Toshiba MSX-ENGINEs embed a CMOS Z80
 {
 	static_assert(!std::is_polymorphic_v<CPUCore<T>>,
 		"keep CPUCore non-virtual to keep PC at offset 0");
+	updateTracing();
 	doSetFreq();
 	doReset(time);
 }
@@ -542,10 +551,16 @@ template<typename T> void CPUCore<T>::update(const Setting& setting) noexcept
 	} else if (&setting == &freqValue) {
 		doSetFreq();
 	} else if (&setting == &traceSetting) {
-		tracingEnabled = traceSetting.getBoolean();
+		updateTracing();
 	}
 }
 
+template<typename T> void CPUCore<T>::updateTracing()
+{
+	tracingEnabled = traceSetting.getBoolean() ||
+	                 heatMap.isEnabled(HeatMap::Type::EXEC);
+}
+
 template<typename T> void CPUCore<T>::setFreq(unsigned freq_)
 {
 	freq = freq_;
@@ -851,6 +866,9 @@ template<typename T>
 void CPUCore<T>::executeInstructions()
 {
 	checkNoCurrentFlags();
+	// Between two calls the Scheduler may have run, so forget the
+	// previous idle loop analysis and measurement.
+	idleLoop.jrAddr = unsigned(-1);
 #ifdef USE_COMPUTED_GOTO
 	// Addresses of all main-opcode routines,
 	// Note that 40/49/53/5B/64/6D/7F is replaced by 00 (ld r,r == nop)
@@ -2463,6 +2481,20 @@ xx_cb: {
 template<typename T> inline void CPUCore<T>::cpuTracePre()
 {
 	start_pc = getPC();
+	if (tracingEnabled) [[unlikely]] {
+		cpuTracePre_slow();
+	}
+}
+template<typename T> void CPUCore<T>::cpuTracePre_slow()
+{
+	if (!traceSetting.getBoolean() || !traceBuffer.isActive()) return;
+	// The instruction may modify its own opcode bytes (or switch the
+	// memory mapping), so read them before it executes.
+	EmuTime time = T::getTimeFast();
+	start_length = narrow<uint8_t>(instructionLength(*interface, start_pc, time));
+	for (auto i : xrange(start_length)) {
+		start_opcode[i] = interface->peekMem(narrow_cast<word>(start_pc + i), time);
+	}
 }
 template<typename T> inline void CPUCore<T>::cpuTracePost()
 {
@@ -2472,6 +2504,32 @@ template<typename T> inline void CPUCore<T>::cpuTracePost()
 }
 template<typename T> void CPUCore<T>::cpuTracePost_slow()
 {
+	if (heatMap.isEnabled(HeatMap::Type::EXEC)) {
+		auto page = start_pc >> 14;
+		heatMap.countMem(HeatMap::Type::EXEC, start_pc,
+		                 interface->getPrimarySlot(page),
+		                 interface->getSecondarySlot(page));
+		if (!traceSetting.getBoolean()) return;
+	}
+	if (traceBuffer.isActive()) {
+		EmuTime time = T::getTimeFast();
+		CPUTraceRecord record = {};
+		record.time = (time - EmuTime::zero()).length();
+		record.pc = start_pc;
+		record.af = getAF(); record.bc = getBC();
+		record.de = getDE(); record.hl = getHL();
+		record.ix = getIX(); record.iy = getIY();
+		record.sp = getSP();
+		record.opcode = start_opcode;
+		record.length = start_length;
+		for (auto page : xrange(4)) {
+			record.primarySlots   |= narrow<uint8_t>(interface->getPrimarySlot  (page) << (2 * page));
+			record.secondarySlots |= narrow<uint8_t>(interface->getSecondarySlot(page) << (2 * page));
+		}
+		traceBuffer.push(record);
+		return;
+	}
+
 	std::array<byte, 4> opBuf;
 	std::string dasmOutput;
 	dasm(*interface, start_pc, opBuf, dasmOutput, T::getTimeFast());
@@ -3967,6 +4025,11 @@ template<typename T> template<typename COND> II CPUCore<T>::jp(COND cond) {
 template<typename T> template<typename COND> II CPUCore<T>::jr(COND cond) {
 	int8_t ofst = RDMEM_OPCODE<1>(T::CC_JR_1);
 	if (cond(getF())) {
+		if constexpr (!T::IS_R800) {
+			if ((ofst < 0) && ((idleLoop.jrAddr != getPC()) || idleLoop.idle)) [[unlikely]] {
+				checkIdleLoop(ofst);
+			}
+		}
 		if (((getPC() + 2) & 0xFF) == 0) { /**/
 			// On R800, when this instruction is located in the
 			// last two byte of a page (a page is a 256-byte
@@ -4005,6 +4068,132 @@ template<typename T> template<typename COND> II CPUCore<T>::jr(COND cond) {
 	}
 }
 
+// Idle loop detection
+//
+// A lot of MSX software busy-waits in a loop that only reads memory and
+// branches, for example waiting until the interrupt routine changes a
+// variable ('ld a,(nn) ; cp b ; jr z,loop') or simply 'jr $'. Such a loop
+// can only end when something else than the CPU changes the memory or
+// raises an interrupt. And that only happens in a Scheduler sync point.
+//
+// isIdleLoop() checks whether the instructions between the target of a
+// backwards 'jr' and that 'jr' itself form such a loop: only side-effect
+// free reads of (cacheable) memory, and every iteration leaves the
+// registers in the same state (no register is read before it's written
+// and written again later in the loop). Then all iterations are identical,
+// so after measuring the duration (and the number of R increments) of one
+// iteration we can skip all iterations that would have fully executed
+// before the next sync point. This is exact, the state afterwards is the
+// same as when all those iterations had been emulated.
+//
+// The R800 is excluded because its timing (refresh, page-breaks) does
+// depend on the absolute time.
+template<typename T> bool CPUCore<T>::isIdleLoop(word begin, word jrAddr) const
+{
+	if ((begin > jrAddr) || (jrAddr - begin) > 16) return false;
+	// Don't skip anything the user may want to observe.
+	if (MSXCPUInterface::anyBreakPoints() || !interface->getWatchPoints().empty() ||
+	    tracingEnabled) {
+		return false;
+	}
+
+	auto cacheable = [&](word addr) {
+		return uintptr_t(readCacheLine[addr >> CacheLine::BITS]) > 1;
+	};
+	auto fetch = [&](word addr) {
+		return readCacheLine[addr >> CacheLine::BITS][addr];
+	};
+	for (unsigned addr = begin; addr <= unsigned(jrAddr + 1); ++addr) {
+		if (!cacheable(word(addr))) return false;
+	}
+
+	// per register (only A and F can be written): read before written
+	// in this loop iteration, written in this iteration
+	bool readA = false, writeA = false;
+	bool readF = false, writeF = false;
+	auto useA = [&] { if (!writeA) readA = true; };
+	auto useF = [&] { if (!writeF) readF = true; };
+	auto source = [&](unsigned r) { // r: register field of the opcode
+		if (r == 6) return cacheable(getHL());
+		if (r == 7) useA();
+		return true;
+	};
+
+	auto pc = begin;
+	while (pc < jrAddr) {
+		byte op = fetch(pc++);
+		if (op == 0x00) { // nop
+		} else if ((op == 0x0A) || (op == 0x1A) || (op == 0x7E)) { // ld a,(bc) / ld a,(de) / ld a,(hl)
+			if (!cacheable((op == 0x0A) ? getBC() : (op == 0x1A) ? getDE() : getHL())) return false;
+			writeA = true;
+		} else if (op == 0x3A) { // ld a,(nn)
+			if (pc + 2 > jrAddr) return false;
+			auto addr = word(fetch(pc) | (fetch(word(pc + 1)) << 8));
+			pc += 2;
+			if (!cacheable(addr)) return false;
+			writeA = true;
+		} else if ((0x78 <= op) && (op <= 0x7F)) { // ld a,r
+			if (!source(op & 7)) return false;
+			writeA = true;
+		} else if ((0x80 <= op) && (op <= 0xBF)) { // add/adc/sub/sbc/and/xor/or/cp r
+			if (!source(op & 7)) return false;
+			useA();
+			if ((op & 0xE8) == 0x88) useF(); // adc, sbc
+			if ((op & 0xF8) != 0xB8) writeA = true; // not cp
+			writeF = true;
+		} else if ((op & 0xC7) == 0xC6) { // alu a,n
+			if (pc + 1 > jrAddr) return false;
+			++pc;
+			useA();
+			if ((op & 0xEF) == 0xCE) useF(); // adc, sbc
+			if (op != 0xFE) writeA = true; // not cp
+			writeF = true;
+		} else if (op == 0xCB) { // only 'bit b,r'
+			if (pc + 1 > jrAddr) return false;
+			byte op2 = fetch(pc++);
+			if ((op2 & 0xC0) != 0x40) return false;
+			if (!source(op2 & 7)) return false;
+			// Keeps the C flag, so this doesn't make the next
+			// iteration depend on the previous one.
+			writeF = true;
+		} else {
+			return false;
+		}
+	}
+	if (pc != jrAddr) return false;
+	if (fetch(jrAddr) != 0x18) useF(); // conditional jr
+	return !(readA && writeA) && !(readF && writeF);
+}
+
+template<typename T> NEVER_INLINE void CPUCore<T>::checkIdleLoop(int8_t ofst)
+{
+	// Called from a taken backwards 'jr', PC still points to the 'jr'.
+	word jrAddr = getPC();
+	if (idleLoop.jrAddr != jrAddr) {
+		idleLoop.jrAddr = jrAddr;
+		idleLoop.idle = isIdleLoop(word(jrAddr + 2 + ofst), jrAddr);
+		idleLoop.measured = false;
+		if (!idleLoop.idle) return;
+	}
+
+	int left = T::getRemaining();
+	if (idleLoop.measured && (idleLoop.af == getAF())) {
+		// One full iteration was executed since the previous call.
+		int loopTicks = idleLoop.remaining - left;
+		if ((loopTicks > 0) && (left >= loopTicks)) {
+			auto n = unsigned(left / loopTicks);
+			T::add(n * unsigned(loopTicks));
+			unsigned loopR = byte(getR() - idleLoop.r) & 0x7F;
+			incR(narrow_cast<byte>(n * loopR));
+			left = T::getRemaining();
+		}
+	}
+	idleLoop.measured = true;
+	idleLoop.remaining = left;
+	idleLoop.r = getR();
+	idleLoop.af = getAF();
+}
+
 // DJNZ e
 template<typename T> II CPUCore<T>::djnz() {
 	byte b = getB() - 1;
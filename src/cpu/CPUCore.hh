@@ -16,6 +16,8 @@
 
 namespace openmsx {
 
+class CPUTraceBuffer;
+class HeatMap;
 class MSXCPUInterface;
 class Scheduler;
 class MSXMotherBoard;
@@ -56,8 +58,8 @@ class CPUCore final : public CPUBase, public CPURegs, public CPU_POLICY
 {
 public:
 	CPUCore(MSXMotherBoard& motherboard, const std::string& name,
-	        const BooleanSetting& traceSetting,
-	        TclCallback& diHaltCallback, EmuTime::param time);
+	        const BooleanSetting& traceSetting, CPUTraceBuffer& traceBuffer,
+	        HeatMap& heatMap, TclCallback& diHaltCallback, EmuTime::param time);
 
 	void setInterface(MSXCPUInterface* interface_) { interface = interface_; }
 
@@ -137,6 +139,8 @@ private:
 
 	// Observer<Setting>  !! non-virtual !!
 	void update(const Setting& setting) noexcept;
+	/** Re-evaluate 'tracingEnabled', e.g. after the heatMap changed. */
+	void updateTracing();
 
 private:
 	// memory cache
@@ -148,6 +152,8 @@ private:
 	MSXCPUInterface* interface = nullptr;
 
 	const BooleanSetting& traceSetting;
+	CPUTraceBuffer& traceBuffer;
+	HeatMap& heatMap;
 	TclCallback& diHaltCallback;
 
 	Probe<int> IRQStatus;
@@ -171,15 +177,28 @@ private:
 
 	std::atomic<bool> exitLoop = false;
 
-	/** In sync with traceSetting.getBoolean(). */
+	/** In sync with traceSetting.getBoolean() or counting executed
+	  * instructions in the heatMap. */
 	bool tracingEnabled;
 
 	/** An NMOS Z80 and a CMOS Z80 behave slightly differently */
 	const bool isCMOS;
 
+	/** Idle loop detection, see checkIdleLoop(). Only valid within one
+	  * call to executeInstructions(). */
+	struct IdleLoop {
+		unsigned jrAddr = unsigned(-1); // address of the analyzed 'jr', -1 -> none
+		bool idle = false;     // analysis result for that 'jr'
+		bool measured = false; // the fields below are valid
+		int remaining = 0;
+		byte r = 0;
+		word af = 0;
+	} idleLoop;
+
 private:
 	inline void cpuTracePre();
 	inline void cpuTracePost();
+	void cpuTracePre_slow();
 	void cpuTracePost_slow();
 
 	inline byte READ_PORT(word port, unsigned cc);
@@ -224,6 +243,8 @@ private:
 	inline void WR_WORD_rev (unsigned address, word value, unsigned cc);
 
 	void executeInstructions();
+	[[nodiscard]] bool isIdleLoop(word begin, word jrAddr) const;
+	void checkIdleLoop(int8_t ofst);
 	inline void nmi();
 	inline void irq0();
 	inline void irq1();
@@ -0,0 +1,261 @@
+#include "CPUTraceBuffer.hh"
+
+#include "CliComm.hh"
+#include "CommandController.hh"
+#include "CommandException.hh"
+#include "EmuDuration.hh"
+#include "Dasm.hh"
+#include "File.hh"
+#include "FileException.hh"
+#include "FileOperations.hh"
+#include "TclObject.hh"
+
+#include "narrow.hh"
+#include "outer.hh"
+#include "strCat.hh"
+#include "xrange.hh"
+
+#include <algorithm>
+#include <array>
+#include <cassert>
+#include <new>
+#include <string_view>
+
+namespace openmsx {
+
+// Trace file format (all integers in host byte order):
+//   16 bytes   magic "openMSX cputrace"
+//    4 bytes   version (currently 1)
+//    4 bytes   size of one record (currently 32)
+//    8 bytes   number of records
+//   followed by the records (oldest first), see CPUTraceRecord
+static constexpr std::string_view TRACE_MAGIC = "openMSX cputrace";
+static constexpr uint32_t TRACE_VERSION = 1;
+
+CPUTraceBuffer::CPUTraceBuffer(CommandController& commandController)
+	: outputSetting(
+		commandController, "cputrace_output",
+		"where 'cputrace' writes to: 'text' prints a disassembled line "
+		"per instruction on stdout, 'buffer' stores a compact record "
+		"in a ring buffer (see 'cputrace_buffer' command)",
+		false, EnumSetting<bool>::Map{{"text", false}, {"buffer", true}},
+		Setting::DONT_SAVE)
+	, cmd(commandController)
+{
+	outputSetting.attach(*this);
+}
+
+CPUTraceBuffer::~CPUTraceBuffer()
+{
+	outputSetting.detach(*this);
+}
+
+const CPUTraceRecord& CPUTraceBuffer::operator[](size_t i) const
+{
+	assert(i < count);
+	size_t first = (head + capacity - count) % capacity;
+	return records[(first + i) % capacity];
+}
+
+std::string CPUTraceBuffer::format(const CPUTraceRecord& record)
+{
+	std::string dasmOutput;
+	dasm(std::span{record.opcode.data(), record.length}, record.pc, dasmOutput);
+	dasmOutput.resize(19, ' ');
+	return strCat(hex_string<4>(record.pc),
+	              " : ", dasmOutput,
+	              " AF=", hex_string<4>(record.af),
+	              " BC=", hex_string<4>(record.bc),
+	              " DE=", hex_string<4>(record.de),
+	              " HL=", hex_string<4>(record.hl),
+	              " IX=", hex_string<4>(record.ix),
+	              " IY=", hex_string<4>(record.iy),
+	              " SP=", hex_string<4>(record.sp));
+}
+
+void CPUTraceBuffer::save(const std::string& filename) const
+{
+	File file(filename, File::OpenMode::TRUNCATE);
+	file.write(std::span{TRACE_MAGIC});
+	std::array<uint32_t, 2> header = {TRACE_VERSION, uint32_t(sizeof(CPUTraceRecord))};
+	file.write(std::span<const uint32_t>{header});
+	std::array<uint64_t, 1> num = {count};
+	file.write(std::span<const uint64_t>{num});
+	// at most two contiguous chunks
+	size_t first = (head + capacity - count) % capacity;
+	size_t num1 = std::min(count, capacity - first);
+	if (num1) file.write(std::span{&records[first], num1});
+	if (count > num1) file.write(std::span{records.data(), count - num1});
+}
+
+void CPUTraceBuffer::setCapacity(size_t newCapacity)
+{
+	assert((0 < newCapacity) && (newCapacity <= MAX_CAPACITY));
+	records.clear(); // first release the old buffer
+	records.shrink_to_fit();
+	try {
+		records.resize(newCapacity);
+	} catch (std::bad_alloc&) {
+		// the old content is already gone, fall back to the default size
+		capacity = DEFAULT_CAPACITY;
+		clear();
+		if (active) update(outputSetting); // allocates
+		throw CommandException("Not enough memory for ", newCapacity,
+		                       " records");
+	}
+	capacity = newCapacity;
+	clear();
+}
+
+void CPUTraceBuffer::update(const Setting& setting) noexcept
+{
+	assert(&setting == &outputSetting); (void)setting;
+	active = outputSetting.getEnum();
+	if (active && records.empty()) {
+		// Allocate now, not on the first recorded instruction (that
+		// would be in the middle of emulation).
+		try {
+			records.resize(capacity);
+		} catch (std::bad_alloc&) {
+			active = false;
+			cmd.getCommandController().getCliComm().printWarning(
+				"Not enough memory for the cputrace buffer, "
+				"'cputrace' keeps printing text.");
+		}
+	}
+}
+
+
+// class Cmd
+
+CPUTraceBuffer::Cmd::Cmd(CommandController& controller)
+	: Command(controller, "cputrace_buffer")
+{
+}
+
+static uint16_t getRegister(const CPUTraceRecord& r, std::string_view reg)
+{
+	if (reg == "pc") return r.pc;
+	if (reg == "af") return r.af;
+	if (reg == "bc") return r.bc;
+	if (reg == "de") return r.de;
+	if (reg == "hl") return r.hl;
+	if (reg == "ix") return r.ix;
+	if (reg == "iy") return r.iy;
+	if (reg == "sp") return r.sp;
+	throw CommandException("Unknown register: ", reg);
+}
+
+void CPUTraceBuffer::Cmd::execute(std::span<const TclObject> tokens, TclObject& result)
+{
+	checkNumArgs(tokens, AtLeast{2}, "subcommand ?arg ...?");
+	auto& buffer = OUTER(CPUTraceBuffer, cmd);
+	auto& interp = getInterpreter();
+	auto getIndex = [&](const TclObject& obj) {
+		auto i = obj.getInt(interp);
+		if ((i < 0) || (size_t(i) >= buffer.size())) {
+			throw CommandException("Index out of range: ", i);
+		}
+		return size_t(i);
+	};
+	executeSubCommand(tokens[1].getString(),
+		"size", [&]{
+			checkNumArgs(tokens, 2, "");
+			result = narrow<int>(buffer.size());
+		},
+		"clear", [&]{
+			checkNumArgs(tokens, 2, "");
+			buffer.clear();
+		},
+		"capacity", [&]{
+			checkNumArgs(tokens, Between{2, 3}, "?num-records?");
+			if (tokens.size() == 3) {
+				auto n = tokens[2].getInt(interp);
+				if ((n <= 0) || (size_t(n) > MAX_CAPACITY)) {
+					throw CommandException(
+						"Capacity must be between 1 and ", MAX_CAPACITY);
+				}
+				buffer.setCapacity(size_t(n));
+			}
+			result = narrow<int>(buffer.capacity);
+		},
+		"get", [&]{
+			checkNumArgs(tokens, 3, "index");
+			const auto& r = buffer[getIndex(tokens[2])];
+			TclObject opcode;
+			for (auto i : xrange(r.length)) opcode.addListElement(r.opcode[i]);
+			result.addDictKeyValues(
+				"time", double(r.time) / double(MAIN_FREQ),
+				"pc", r.pc, "af", r.af, "bc", r.bc, "de", r.de,
+				"hl", r.hl, "ix", r.ix, "iy", r.iy, "sp", r.sp,
+				"opcode", opcode,
+				"pslot", r.primarySlots, "sslot", r.secondarySlots);
+		},
+		"dasm", [&]{
+			checkNumArgs(tokens, Between{3, 4}, "index ?num?");
+			auto first = getIndex(tokens[2]);
+			size_t num = (tokens.size() == 4) ? size_t(std::max(0, tokens[3].getInt(interp))) : 1;
+			num = std::min(num, buffer.size() - first);
+			for (auto i : xrange(num)) {
+				result.addListElement(format(buffer[first + i]));
+			}
+		},
+		"find", [&]{
+			checkNumArgs(tokens, Between{4, 5}, "register value ?start-index?");
+			auto reg = tokens[2].getString();
+			auto value = narrow_cast<uint16_t>(tokens[3].getInt(interp));
+			size_t start = (tokens.size() == 5) ? getIndex(tokens[4]) : 0;
+			result = -1;
+			for (auto i : xrange(start, buffer.size())) {
+				if (getRegister(buffer[i], reg) == value) {
+					result = narrow<int>(i);
+					break;
+				}
+			}
+		},
+		"save", [&]{
+			checkNumArgs(tokens, 3, "filename");
+			auto filename = FileOperations::expandTilde(std::string(tokens[2].getString()));
+			try {
+				buffer.save(filename);
+			} catch (FileException& e) {
+				throw CommandException("Couldn't save cpu trace: ", e.getMessage());
+			}
+		});
+}
+
+std::string CPUTraceBuffer::Cmd::help(std::span<const TclObject> /*tokens*/) const
+{
+	return "Inspect the instructions recorded by 'cputrace' when the "
+	       "'cputrace_output' setting is set to 'buffer'.\n"
+	       "Index 0 is the oldest recorded instruction.\n"
+	       "  size                          number of recorded instructions\n"
+	       "  clear                         remove all recorded instructions\n"
+	       "  capacity [<num>]              get or set the maximum number of recorded instructions\n"
+	       "                                (at most 33554432, each takes 32 bytes)\n"
+	       "  get <index>                   get the details of one instruction as a dict\n"
+	       "  dasm <index> [<num>]          disassemble one or more instructions\n"
+	       "  find <reg> <value> [<start>]  index of the first instruction (at or after <start>)\n"
+	       "                                with the given register (pc af bc de hl ix iy sp)\n"
+	       "                                value, -1 if not found\n"
+	       "  save <filename>               save all instructions to a binary file\n";
+}
+
+void CPUTraceBuffer::Cmd::tabCompletion(std::vector<std::string>& tokens) const
+{
+	using namespace std::literals;
+	if (tokens.size() == 2) {
+		static constexpr std::array subCommands = {
+			"size"sv, "clear"sv, "capacity"sv, "get"sv, "dasm"sv,
+			"find"sv, "save"sv,
+		};
+		completeString(tokens, subCommands);
+	} else if ((tokens.size() == 3) && (tokens[1] == "find")) {
+		static constexpr std::array regs = {
+			"pc"sv, "af"sv, "bc"sv, "de"sv, "hl"sv, "ix"sv, "iy"sv, "sp"sv,
+		};
+		completeString(tokens, regs);
+	}
+}
+
+} // namespace openmsx
@@ -0,0 +1,101 @@
+#ifndef CPUTRACEBUFFER_HH
+#define CPUTRACEBUFFER_HH
+
+#include "Command.hh"
+#include "EnumSetting.hh"
+#include "Observer.hh"
+
+#include <array>
+#include <cassert>
+#include <cstdint>
+#include <string>
+#include <vector>
+
+namespace openmsx {
+
+class CommandController;
+class Setting;
+class TclObject;
+
+/** Compact (fixed-size) record of one executed instruction, as stored in the
+  * CPUTraceBuffer and in saved trace files.
+  */
+struct CPUTraceRecord
+{
+	uint64_t time; // EmuTime in ticks of MAIN_FREQ (at the end of the instruction)
+	uint16_t pc; // address of the instruction
+	uint16_t af, bc, de, hl, ix, iy, sp; // registers after the instruction
+	std::array<uint8_t, 4> opcode; // only the first 'length' bytes are valid
+	uint8_t length;
+	uint8_t primarySlots;   // 2 bits per page, page 0 in the lowest bits
+	uint8_t secondarySlots; // same format as 'primarySlots'
+	uint8_t pad = 0;
+};
+static_assert(sizeof(CPUTraceRecord) == 32);
+
+/** Alternative for the text output of the 'cputrace' setting: instead of
+  * printing a disassembled line per instruction to stdout, store a compact
+  * record in a fixed-size ring buffer. The buffer can later be inspected or
+  * saved to a (binary) file via the 'cputrace_buffer' command.
+  */
+class CPUTraceBuffer final : private Observer<Setting>
+{
+public:
+	static constexpr size_t DEFAULT_CAPACITY = 256 * 1024; // 8MB
+	static constexpr size_t MAX_CAPACITY = 32 * 1024 * 1024; // 1GB
+
+	explicit CPUTraceBuffer(CommandController& commandController);
+	~CPUTraceBuffer();
+
+	/** Should 'cputrace' record into this buffer (instead of printing)? */
+	[[nodiscard]] bool isActive() const { return active; }
+
+	void push(const CPUTraceRecord& record) {
+		assert(!records.empty()); // allocated when activated
+		records[head] = record;
+		if (++head == capacity) head = 0;
+		if (count < capacity) ++count;
+	}
+
+	[[nodiscard]] size_t size() const { return count; }
+	void clear() { head = 0; count = 0; }
+
+	/** Get the i-th record, 0 is the oldest record still in the buffer. */
+	[[nodiscard]] const CPUTraceRecord& operator[](size_t i) const;
+
+	/** Format a record in the same way as the text output of 'cputrace'. */
+	[[nodiscard]] static std::string format(const CPUTraceRecord& record);
+
+	/** Write all records (oldest first) to a file.
+	  * @throws FileException */
+	void save(const std::string& filename) const;
+
+private:
+	/** Change the capacity, this also clears the buffer.
+	  * @throws CommandException when the memory can't be allocated, in
+	  *         that case the buffer remains unchanged. */
+	void setCapacity(size_t newCapacity);
+
+	// Observer<Setting>
+	void update(const Setting& setting) noexcept override;
+
+private:
+	EnumSetting<bool> outputSetting;
+
+	struct Cmd final : Command {
+		explicit Cmd(CommandController& controller);
+		void execute(std::span<const TclObject> tokens, TclObject& result) override;
+		[[nodiscard]] std::string help(std::span<const TclObject> tokens) const override;
+		void tabCompletion(std::vector<std::string>& tokens) const override;
+	} cmd;
+
+	std::vector<CPUTraceRecord> records; // allocated when first activated
+	size_t capacity = DEFAULT_CAPACITY;
+	size_t head = 0; // position of the next record to write
+	size_t count = 0;
+	bool active = false;
+};
+
+} // namespace openmsx
+
+#endif
@@ -6,6 +6,8 @@
 #include "narrow.hh"
 #include "strCat.hh"
 
+#include <array>
+
 namespace openmsx {
 
 static constexpr char sign(uint8_t a)
@@ -23,30 +25,31 @@ void appendAddrAsHex(std::string& output, uint16_t addr)
 	strAppend(output, '#', hex_string<4>(addr));
 }
 
-unsigned dasm(const MSXCPUInterface& interface, uint16_t pc, std::span<uint8_t, 4> buf,
-              std::string& dest, EmuTime::param time,
-              function_ref<void(std::string&, uint16_t)> appendAddr)
+template<typename Peek>
+static unsigned dasmImpl(Peek peek, uint16_t pc, std::span<uint8_t, 4> buf,
+                         std::string& dest,
+                         function_ref<void(std::string&, uint16_t)> appendAddr)
 {
 	const char* r = nullptr;
 
-	buf[0] = interface.peekMem(pc, time);
+	buf[0] = peek(pc);
 	auto [s, i] = [&]() -> std::pair<const char*, unsigned> {
 		switch (buf[0]) {
 			case 0xCB:
-				buf[1] = interface.peekMem(pc + 1, time);
+				buf[1] = peek(pc + 1);
 				return {mnemonic_cb[buf[1]], 2};
 			case 0xED:
-				buf[1] = interface.peekMem(pc + 1, time);
+				buf[1] = peek(pc + 1);
 				return {mnemonic_ed[buf[1]], 2};
 			case 0xDD:
 			case 0xFD:
 				r = (buf[0] == 0xDD) ? "ix" : "iy";
-				buf[1] = interface.peekMem(pc + 1, time);
+				buf[1] = peek(pc + 1);
 				if (buf[1] != 0xcb) {
 					return {mnemonic_xx[buf[1]], 2};
 				} else {
-					buf[2] = interface.peekMem(pc + 2, time);
-					buf[3] = interface.peekMem(pc + 3, time);
+					buf[2] = peek(pc + 2);
+					buf[3] = peek(pc + 3);
 					return {mnemonic_xx_cb[buf[3]], 4};
 				}
 			default:
@@ -57,25 +60,25 @@ unsigned dasm(const MSXCPUInterface& interface, uint16_t pc, std::span<uint8_t,
 	for (int j = 0; s[j]; ++j) {
 		switch (s[j]) {
 		case 'B':
-			buf[i] = interface.peekMem(narrow_cast<uint16_t>(pc + i), time);
+			buf[i] = peek(narrow_cast<uint16_t>(pc + i));
 			strAppend(dest, '#', hex_string<2>(
 				static_cast<uint16_t>(buf[i])));
 			i += 1;
 			break;
 		case 'R':
-			buf[i] = interface.peekMem(narrow_cast<uint16_t>(pc + i), time);
+			buf[i] = peek(narrow_cast<uint16_t>(pc + i));
 			appendAddr(dest, uint16_t(pc + 2 + static_cast<int8_t>(buf[i])));
 			i += 1;
 			break;
 		case 'A':
 		case 'W':
-			buf[i + 0] = interface.peekMem(narrow_cast<uint16_t>(pc + i + 0), time);
-			buf[i + 1] = interface.peekMem(narrow_cast<uint16_t>(pc + i + 1), time);
+			buf[i + 0] = peek(narrow_cast<uint16_t>(pc + i + 0));
+			buf[i + 1] = peek(narrow_cast<uint16_t>(pc + i + 1));
 			appendAddr(dest, buf[i] + buf[i + 1] * 256);
 			i += 2;
 			break;
 		case 'X':
-			buf[i] = interface.peekMem(narrow_cast<uint16_t>(pc + i), time);
+			buf[i] = peek(narrow_cast<uint16_t>(pc + i));
 			strAppend(dest, '(', r, sign(buf[i]), '#',
 			     hex_string<2>(abs(buf[i])), ')');
 			i += 1;
@@ -111,6 +114,25 @@ unsigned dasm(const MSXCPUInterface& interface, uint16_t pc, std::span<uint8_t,
 	return i;
 }
 
+unsigned dasm(const MSXCPUInterface& interface, uint16_t pc, std::span<uint8_t, 4> buf,
+              std::string& dest, EmuTime::param time,
+              function_ref<void(std::string&, uint16_t)> appendAddr)
+{
+	return dasmImpl([&](uint16_t addr) { return interface.peekMem(addr, time); },
+	                pc, buf, dest, appendAddr);
+}
+
+unsigned dasm(std::span<const uint8_t> opcode, uint16_t pc, std::string& dest,
+              function_ref<void(std::string&, uint16_t)> appendAddr)
+{
+	auto peek = [&](uint16_t addr) -> uint8_t {
+		auto i = uint16_t(addr - pc);
+		return (i < opcode.size()) ? opcode[i] : 0;
+	};
+	std::array<uint8_t, 4> buf;
+	return dasmImpl(peek, pc, buf, dest, appendAddr);
+}
+
 unsigned instructionLength(const MSXCPUInterface& interface, uint16_t pc,
                            EmuTime::param time)
 {
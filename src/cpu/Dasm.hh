@@ -29,6 +29,16 @@ unsigned dasm(const MSXCPUInterface& interface, uint16_t pc, std::span<uint8_t,
               std::string& dest, EmuTime::param time,
               function_ref<void(std::string&, uint16_t)> appendAddr = &appendAddrAsHex);
 
+/** Disassemble an already fetched opcode.
+  * @param opcode The bytes of the instruction (at most 4). Bytes beyond the
+  *               end of this buffer are taken as zero.
+  * @param pc The address of the instruction, needed for relative jumps
+  * @param dest String representation of the disassembled opcode
+  * @return Length of the disassembled opcode in bytes
+  */
+unsigned dasm(std::span<const uint8_t> opcode, uint16_t pc, std::string& dest,
+              function_ref<void(std::string&, uint16_t)> appendAddr = &appendAddrAsHex);
+
 /** Calculate the length of the instruction at the given address.
   * This is exactly the same value as calculated by the dasm() function above,
   * though this function executes much faster.
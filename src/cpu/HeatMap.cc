@@ -0,0 +1,186 @@
+#include "HeatMap.hh"
+
+#include "CommandException.hh"
+#include "TclObject.hh"
+
+#include "narrow.hh"
+#include "outer.hh"
+#include "ranges.hh"
+#include "xrange.hh"
+
+#include <algorithm>
+#include <utility>
+
+namespace openmsx {
+
+HeatMap::HeatMap(CommandController& commandController)
+	: cmd(commandController)
+{
+}
+
+void HeatMap::setEnabled(Type type, bool enable)
+{
+	auto t = size_t(type);
+	if (enabled[t] == enable) return;
+	if (enable && (t < NUM_MEM_TYPES) && memCounts[t].empty()) {
+		memCounts[t].resize(0x10000);
+	}
+	enabled[t] = enable;
+	notify();
+}
+
+void HeatMap::clear(Type type)
+{
+	auto t = size_t(type);
+	if (t < NUM_MEM_TYPES) {
+		ranges::fill(memCounts[t], 0);
+		ranges::fill(slotCounts[t], 0);
+	} else {
+		ranges::fill(ioCounts[t - NUM_MEM_TYPES], 0);
+	}
+	++generation;
+}
+
+std::span<const uint64_t> HeatMap::getCounts(Type type) const
+{
+	auto t = size_t(type);
+	if (t < NUM_MEM_TYPES) return memCounts[t];
+	return ioCounts[t - NUM_MEM_TYPES];
+}
+
+
+// class Cmd
+
+HeatMap::Cmd::Cmd(CommandController& controller)
+	: Command(controller, "heatmap")
+{
+}
+
+static HeatMap::Type parseType(std::string_view str)
+{
+	for (auto t : xrange(HeatMap::NUM_TYPES)) {
+		if (HeatMap::typeNames[t] == str) return HeatMap::Type(t);
+	}
+	throw CommandException("Unknown type: ", str);
+}
+
+static std::vector<HeatMap::Type> parseTypes(std::span<const TclObject> tokens)
+{
+	std::vector<HeatMap::Type> result;
+	if (tokens.empty()) {
+		for (auto t : xrange(HeatMap::NUM_TYPES)) result.push_back(HeatMap::Type(t));
+	} else {
+		for (const auto& token : tokens) result.push_back(parseType(token.getString()));
+	}
+	return result;
+}
+
+static TclObject countObj(uint64_t count)
+{
+	return TclObject(Tcl_NewWideIntObj(narrow_cast<Tcl_WideInt>(count)));
+}
+
+void HeatMap::Cmd::execute(std::span<const TclObject> tokens, TclObject& result)
+{
+	checkNumArgs(tokens, AtLeast{2}, "subcommand ?arg ...?");
+	auto& heatMap = OUTER(HeatMap, cmd);
+	auto& interp = getInterpreter();
+	executeSubCommand(tokens[1].getString(),
+		"enable", [&]{
+			for (auto t : parseTypes(tokens.subspan(2))) heatMap.setEnabled(t, true);
+		},
+		"disable", [&]{
+			for (auto t : parseTypes(tokens.subspan(2))) heatMap.setEnabled(t, false);
+		},
+		"status", [&]{
+			checkNumArgs(tokens, 2, "");
+			for (auto t : xrange(NUM_TYPES)) {
+				result.addDictKeyValue(typeNames[t], heatMap.isEnabled(Type(t)));
+			}
+		},
+		"clear", [&]{
+			for (auto t : parseTypes(tokens.subspan(2))) heatMap.clear(t);
+		},
+		"get", [&]{
+			checkNumArgs(tokens, Between{3, 5}, "type ?begin? ?end?");
+			auto counts = heatMap.getCounts(parseType(tokens[2].getString()));
+			auto size = (tokens[2] == "in" || tokens[2] == "out") ? 256 : 0x10000;
+			auto begin = (tokens.size() > 3) ? tokens[3].getInt(interp) : 0;
+			auto end   = (tokens.size() > 4) ? tokens[4].getInt(interp) : size;
+			if ((begin < 0) || (end > size) || (begin > end)) {
+				throw CommandException("Invalid range");
+			}
+			for (auto i : xrange(begin, end)) {
+				result.addListElement(countObj(counts.empty() ? 0 : counts[i]));
+			}
+		},
+		"top", [&]{
+			checkNumArgs(tokens, Between{3, 4}, "type ?num?");
+			auto counts = heatMap.getCounts(parseType(tokens[2].getString()));
+			auto num = (tokens.size() > 3) ? size_t(std::max(0, tokens[3].getInt(interp))) : 10;
+			std::vector<std::pair<unsigned, uint64_t>> hot;
+			for (auto i : xrange(counts.size())) {
+				if (counts[i]) hot.emplace_back(narrow<unsigned>(i), counts[i]);
+			}
+			num = std::min(num, hot.size());
+			std::partial_sort(hot.begin(), hot.begin() + num, hot.end(),
+				[](const auto& x, const auto& y) { return x.second > y.second; });
+			for (const auto& [addr, count] : std::span{hot}.first(num)) {
+				result.addListElement(makeTclList(addr, countObj(count)));
+			}
+		},
+		"slots", [&]{
+			checkNumArgs(tokens, 3, "type");
+			auto type = parseType(tokens[2].getString());
+			if (size_t(type) >= NUM_MEM_TYPES) {
+				throw CommandException("Only available for read, write and exec");
+			}
+			auto counts = heatMap.getSlotCounts(type);
+			for (auto i : xrange(counts.size())) {
+				if (counts[i] == 0) continue;
+				auto ps = i / 16;
+				auto ss = (i / 4) % 4;
+				auto page = i % 4;
+				result.addListElement(makeTclList(
+					narrow<int>(ps), narrow<int>(ss), narrow<int>(page),
+					countObj(counts[i])));
+			}
+		});
+}
+
+std::string HeatMap::Cmd::help(std::span<const TclObject> /*tokens*/) const
+{
+	return "Count the memory and IO accesses of the CPU.\n"
+	       "<type> is one of: read write exec in out\n"
+	       "  enable [<type> ...]          start counting (default: all types)\n"
+	       "  disable [<type> ...]         stop counting (default: all types)\n"
+	       "  status                       dict with the enabled state per type\n"
+	       "  clear [<type> ...]           reset the counters to zero (default: all types)\n"
+	       "  get <type> [<begin> [<end>]] list of counters per address (or per IO port)\n"
+	       "  top <type> [<num>]           the <num> (default 10) most accessed addresses,\n"
+	       "                               as a list of {address count} pairs\n"
+	       "  slots <type>                 non-zero counters per slot and page, as a list\n"
+	       "                               of {primary secondary page count} tuples\n"
+	       "Cost: counting 'read' or 'write' accesses disables the CPU memory cache\n"
+	       "for the whole address space, so every access takes the slow path through\n"
+	       "the slot layout. This slows down emulation a lot, so only enable these\n"
+	       "while profiling. Counting 'exec' makes the CPU run in single-instruction\n"
+	       "mode (like 'cputrace'), also a noticeable slowdown. 'in' and 'out' are\n"
+	       "cheap, and types that are disabled cost nothing.\n";
+}
+
+void HeatMap::Cmd::tabCompletion(std::vector<std::string>& tokens) const
+{
+	using namespace std::literals;
+	if (tokens.size() == 2) {
+		static constexpr std::array subCommands = {
+			"enable"sv, "disable"sv, "status"sv, "clear"sv, "get"sv,
+			"top"sv, "slots"sv,
+		};
+		completeString(tokens, subCommands);
+	} else if (tokens.size() >= 3) {
+		completeString(tokens, typeNames);
+	}
+}
+
+} // namespace openmsx
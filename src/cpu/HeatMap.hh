@@ -0,0 +1,91 @@
+#ifndef HEATMAP_HH
+#define HEATMAP_HH
+
+#include "Command.hh"
+#include "Subject.hh"
+
+#include <array>
+#include <cassert>
+#include <cstdint>
+#include <span>
+#include <string_view>
+#include <vector>
+
+namespace openmsx {
+
+class CommandController;
+
+/** Counts the memory accesses of the emulated CPU: reads, writes and
+  * executed instructions per 16-bit address (and per slot and page), plus
+  * IO reads and writes per port. Meant to profile MSX software: which
+  * routines are hot and where the memory and IO traffic goes.
+  *
+  * Each type can be enabled separately, because they have a different cost:
+  * - 'read' and 'write' make the CPU bypass its memory cache lines, so
+  *   every access takes the slow path (a lot slower for memory-bound code).
+  * - 'exec' makes the CPU execute one instruction at a time (like 'cputrace').
+  * - 'in' and 'out' are almost free (and completely free when disabled).
+  * Observers are notified when the set of enabled types changes.
+  */
+class HeatMap final : public Subject<HeatMap>
+{
+public:
+	enum class Type : uint8_t { READ, WRITE, EXEC, IN, OUT, NUM };
+	static constexpr auto NUM_TYPES = size_t(Type::NUM);
+	static constexpr size_t NUM_MEM_TYPES = 3; // READ, WRITE, EXEC
+	static constexpr std::array<std::string_view, NUM_TYPES> typeNames = {
+		"read", "write", "exec", "in", "out",
+	};
+
+	explicit HeatMap(CommandController& commandController);
+
+	[[nodiscard]] bool isEnabled(Type type) const { return enabled[size_t(type)]; }
+	void setEnabled(Type type, bool enable);
+	void clear(Type type);
+
+	void countMem(Type type, uint16_t address, unsigned ps, unsigned ss) {
+		auto t = size_t(type);
+		assert(t < NUM_MEM_TYPES);
+		++memCounts[t][address];
+		++slotCounts[t][(ps * 4 + ss) * 4 + (address >> 14)];
+		++generation;
+	}
+	void countIO(Type type, uint8_t port) {
+		auto t = size_t(type) - NUM_MEM_TYPES;
+		assert(t < 2);
+		++ioCounts[t][port];
+		++generation;
+	}
+
+	/** Changes whenever any of the counters changes. Allows to cache
+	  * derived data (e.g. a rendered image of the counts). */
+	[[nodiscard]] uint64_t getGeneration() const { return generation; }
+
+	/** Counts per address (or per port), empty if never enabled. */
+	[[nodiscard]] std::span<const uint64_t> getCounts(Type type) const;
+
+	/** Counts per (primary slot, secondary slot, page):
+	  *   index = (ps * 4 + ss) * 4 + page   (only for memory types). */
+	[[nodiscard]] std::span<const uint64_t, 64> getSlotCounts(Type type) const {
+		assert(size_t(type) < NUM_MEM_TYPES);
+		return slotCounts[size_t(type)];
+	}
+
+private:
+	std::array<bool, NUM_TYPES> enabled = {};
+	std::array<std::vector<uint64_t>, NUM_MEM_TYPES> memCounts; // allocated when first enabled
+	std::array<std::array<uint64_t, 64>, NUM_MEM_TYPES> slotCounts = {};
+	std::array<std::array<uint64_t, 256>, 2> ioCounts = {};
+	uint64_t generation = 0;
+
+	struct Cmd final : Command {
+		explicit Cmd(CommandController& controller);
+		void execute(std::span<const TclObject> tokens, TclObject& result) override;
+		[[nodiscard]] std::string help(std::span<const TclObject> tokens) const override;
+		void tabCompletion(std::vector<std::string>& tokens) const override;
+	} cmd;
+};
+
+} // namespace openmsx
+
+#endif
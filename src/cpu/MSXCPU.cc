@@ -23,17 +23,19 @@ MSXCPU::MSXCPU(MSXMotherBoard& motherboard_)
 	, traceSetting(
 		motherboard.getCommandController(), "cputrace",
 		"CPU tracing on/off", false, Setting::DONT_SAVE)
+	, traceBuffer(motherboard.getCommandController())
+	, heatMap(motherboard.getCommandController())
 	, diHaltCallback(
 		motherboard.getCommandController(), "di_halt_callback",
 		"Tcl proc called when the CPU executed a DI/HALT sequence",
 		"default_di_halt_callback",
 		Setting::SaveSetting::SAVE) // user must be able to override
 	, z80(std::make_unique<CPUCore<Z80TYPE>>(
-		motherboard, "z80", traceSetting,
+		motherboard, "z80", traceSetting, traceBuffer, heatMap,
 		diHaltCallback, EmuTime::zero()))
 	, r800(motherboard.isTurboR()
 		? std::make_unique<CPUCore<R800TYPE>>(
-			motherboard, "r800", traceSetting,
+			motherboard, "r800", traceSetting, traceBuffer, heatMap,
 			diHaltCallback, EmuTime::zero())
 		: nullptr)
 	, timeInfo(motherboard.getMachineInfoCommand())
@@ -47,6 +49,7 @@ MSXCPU::MSXCPU(MSXMotherBoard& motherboard_)
 	motherboard.getDebugger().setCPU(this);
 	motherboard.getScheduler().setCPU(this);
 	traceSetting.attach(*this);
+	heatMap.attach(*this);
 
 	z80->freqLocked.attach(*this);
 	z80->freqValue.attach(*this);
@@ -60,6 +63,7 @@ MSXCPU::MSXCPU(MSXMotherBoard& motherboard_)
 MSXCPU::~MSXCPU()
 {
 	traceSetting.detach(*this);
+	heatMap.detach(*this);
 	z80->freqLocked.detach(*this);
 	z80->freqValue.detach(*this);
 	if (r800) {
@@ -227,11 +231,25 @@ void MSXCPU::setRWCache(unsigned start, unsigned size, const byte* rData, byte*
 	unsigned first = start / CacheLine::SIZE;
 	unsigned num = size / CacheLine::SIZE;
 
+	// All cache lines of a (part of a) segment map to the same (offset
+	// adjusted) pointer. So unless some lines are marked as non-cacheable
+	// (only when debug features like watchpoints or the heat map are
+	// active) a bank switch boils down to filling a block of identical
+	// values, which the compiler turns into a few wide stores.
 	static auto* const NON_CACHEABLE = std::bit_cast<byte*>(uintptr_t(1));
-	for (auto i : xrange(num)) {
-		if constexpr (READ)  readLines [first + i] = disallowRead [first + i] ? NON_CACHEABLE : rData;
-		if constexpr (WRITE) writeLines[first + i] = disallowWrite[first + i] ? NON_CACHEABLE : wData;
-	}
+	auto setLines = [&](auto lines, std::span<const byte, 256> disallow, auto* data) {
+		auto dst = subspan(lines, first, num);
+		auto dis = subspan(disallow, first, num);
+		if (ranges::all_of(dis, [](byte b) { return b == 0; })) {
+			ranges::fill(dst, data);
+		} else {
+			for (auto i : xrange(num)) {
+				dst[i] = dis[i] ? NON_CACHEABLE : data;
+			}
+		}
+	};
+	if constexpr (READ)  setLines(readLines,  disallowRead,  rData);
+	if constexpr (WRITE) setLines(writeLines, disallowWrite, wData);
 }
 
 static constexpr void extendForAlignment(unsigned& start, unsigned& size)
@@ -352,6 +370,14 @@ void MSXCPU::update(const Setting& setting) noexcept
 	exitCPULoopSync();
 }
 
+void MSXCPU::update(const HeatMap& /*heatMap*/) noexcept
+{
+	          z80 ->updateTracing();
+	if (r800) r800->updateTracing();
+	if (interface) interface->updateHeatMap();
+	exitCPULoopSync();
+}
+
 // Command
 
 void MSXCPU::disasmCommand(
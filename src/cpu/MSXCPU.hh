@@ -6,6 +6,8 @@
 #include "Observer.hh"
 #include "BooleanSetting.hh"
 #include "CacheLine.hh"
+#include "CPUTraceBuffer.hh"
+#include "HeatMap.hh"
 #include "EmuTime.hh"
 #include "TclCallback.hh"
 #include "serialize_meta.hh"
@@ -26,7 +28,7 @@ template<typename T> class CPUCore;
 class TclObject;
 class Interpreter;
 
-class MSXCPU final : private Observer<Setting>
+class MSXCPU final : private Observer<Setting>, private Observer<HeatMap>
 {
 public:
 	enum class Type { Z80, R800 };
@@ -151,9 +153,15 @@ public:
 
 	[[nodiscard]] CPURegs& getRegisters();
 
+	/** The moment of the last reset, 'machine_info time' is relative to
+	  * this moment. */
+	[[nodiscard]] EmuTime::param getResetTime() const { return reference; }
+
 	[[nodiscard]] auto* getZ80() { return z80.get(); }
 	[[nodiscard]] auto* getR800() { return r800.get(); }
 
+	[[nodiscard]] HeatMap& getHeatMap() { return heatMap; }
+
 	template<typename Archive>
 	void serialize(Archive& ar, unsigned version);
 
@@ -173,6 +181,8 @@ private:
 
 	// Observer<Setting>
 	void update(const Setting& setting) noexcept override;
+	// Observer<HeatMap>
+	void update(const HeatMap& heatMap) noexcept override;
 
 	template<bool READ, bool WRITE, bool SUB_START>
 	void setRWCache(unsigned start, unsigned size, const byte* rData, byte* wData, int ps, int ss,
@@ -181,6 +191,8 @@ private:
 private:
 	MSXMotherBoard& motherboard;
 	BooleanSetting traceSetting;
+	CPUTraceBuffer traceBuffer;
+	HeatMap heatMap;
 	TclCallback diHaltCallback;
 	const std::unique_ptr<CPUCore<Z80TYPE>> z80;
 	const std::unique_ptr<CPUCore<R800TYPE>> r800; // can be nullptr
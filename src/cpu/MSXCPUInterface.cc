@@ -1,6 +1,7 @@
 #include "MSXCPUInterface.hh"
 
 #include "BooleanSetting.hh"
+#include "CPURegs.hh"
 #include "CartridgeSlotManager.hh"
 #include "CommandException.hh"
 #include "DeviceFactory.hh"
@@ -50,6 +51,7 @@ static unsigned breakedSettingCount = 0;
 static constexpr byte SECONDARY_SLOT_BIT = 0x01;
 static constexpr byte MEMORY_WATCH_BIT   = 0x02;
 static constexpr byte GLOBAL_RW_BIT      = 0x04;
+static constexpr byte HEATMAP_BIT        = 0x08;
 
 std::ostream& operator<<(std::ostream& os, EnumTypeName<CacheLineCounters>)
 {
@@ -89,6 +91,7 @@ MSXCPUInterface::MSXCPUInterface(MSXMotherBoard& motherBoard_)
 	, dummyDevice(DeviceFactory::createDummyDevice(
 		*motherBoard_.getMachineConfig()))
 	, msxcpu(motherBoard_.getCPU())
+	, heatMap(msxcpu.getHeatMap())
 	, cliComm(motherBoard_.getMSXCliComm())
 	, motherBoard(motherBoard_)
 	, pauseSetting(motherBoard.getReactor().getGlobalSettings().getPauseSetting())
@@ -137,6 +140,29 @@ MSXCPUInterface::MSXCPUInterface(MSXMotherBoard& motherBoard_)
 	reset();
 }
 
+// Counts the accesses to all IO ports for the heatmap.
+struct MSXCPUInterface::HeatMapIO final : IOWatcher
+{
+	HeatMapIO(HeatMap& heatMap_, HeatMap::Type type_, const HardwareConfig& config)
+		: heatMap(heatMap_), type(type_)
+	{
+		for (auto& d : devices) {
+			d = std::make_unique<MSXWatchIODevice>(config, *this);
+		}
+	}
+
+	void doReadCallback(unsigned port, EmuTime::param /*time*/) override {
+		heatMap.countIO(type, narrow_cast<uint8_t>(port));
+	}
+	void doWriteCallback(unsigned port, unsigned /*value*/, EmuTime::param /*time*/) override {
+		heatMap.countIO(type, narrow_cast<uint8_t>(port));
+	}
+
+	HeatMap& heatMap;
+	HeatMap::Type type;
+	std::array<std::unique_ptr<MSXWatchIODevice>, 256> devices;
+};
+
 MSXCPUInterface::~MSXCPUInterface()
 {
 	if (--breakedSettingCount == 0) {
@@ -145,6 +171,8 @@ MSXCPUInterface::~MSXCPUInterface()
 	}
 
 	removeAllWatchPoints();
+	setHeatMapIO(heatMapIn,  false, HeatMap::Type::IN,  IO_In);
+	setHeatMapIO(heatMapOut, false, HeatMap::Type::OUT, IO_Out);
 
 	if (delayDevice) {
 		for (auto port : xrange(0x98, 0x9c)) {
@@ -191,8 +219,13 @@ void MSXCPUInterface::removeAllWatchPoints()
 byte MSXCPUInterface::readMemSlow(word address, EmuTime::param time)
 {
 	tick(CacheLineCounters::DisallowCacheRead);
+	if (heatMap.isEnabled(HeatMap::Type::READ)) [[unlikely]] {
+		auto page = address >> 14;
+		heatMap.countMem(HeatMap::Type::READ, address,
+		                 primarySlotState[page], secondarySlotState[page]);
+	}
 	// something special in this region?
-	if (disallowReadCache[address >> CacheLine::BITS]) [[unlikely]] {
+	if (disallowReadCache[address >> CacheLine::BITS] & ~HEATMAP_BIT) [[unlikely]] {
 		// slot-select-ignore reads (e.g. used in 'Carnivore2')
 		for (auto& g : globalReads) {
 			// very primitive address selection mechanism,
@@ -204,7 +237,7 @@ byte MSXCPUInterface::readMemSlow(word address, EmuTime::param time)
 		// execute read watches before actual read
 		if (readWatchSet[address >> CacheLine::BITS]
 		                [address &  CacheLine::LOW]) {
-			executeMemWatch(WatchPoint::Type::READ_MEM, address);
+			executeMemWatch(WatchPoint::Type::READ_MEM, address, time);
 		}
 	}
 	if ((address == 0xFFFF) && isExpanded(primarySlotState[3])) [[unlikely]] {
@@ -217,6 +250,11 @@ byte MSXCPUInterface::readMemSlow(word address, EmuTime::param time)
 void MSXCPUInterface::writeMemSlow(word address, byte value, EmuTime::param time)
 {
 	tick(CacheLineCounters::DisallowCacheWrite);
+	if (heatMap.isEnabled(HeatMap::Type::WRITE)) [[unlikely]] {
+		auto page = address >> 14;
+		heatMap.countMem(HeatMap::Type::WRITE, address,
+		                 primarySlotState[page], secondarySlotState[page]);
+	}
 	if ((address == 0xFFFF) && isExpanded(primarySlotState[3])) [[unlikely]] {
 		setSubSlot(primarySlotState[3], value);
 		// Confirmed on turboR GT machine: write does _not_ also go to
@@ -226,7 +264,7 @@ void MSXCPUInterface::writeMemSlow(word address, byte value, EmuTime::param time
 		visibleDevices[address>>14]->writeMem(address, value, time);
 	}
 	// something special in this region?
-	if (disallowWriteCache[address >> CacheLine::BITS]) [[unlikely]] {
+	if (disallowWriteCache[address >> CacheLine::BITS] & ~HEATMAP_BIT) [[unlikely]] {
 		// slot-select-ignore writes (Super Lode Runner)
 		for (auto& g : globalWrites) {
 			// very primitive address selection mechanism,
@@ -236,15 +274,9 @@ void MSXCPUInterface::writeMemSlow(word address, byte value, EmuTime::param time
 			}
 		}
 		// Execute write watches after actual write.
-		//
-		// But first advance time for the tiniest amount, this makes
-		// sure that later on a possible replay we also replay recorded
-		// commands after the actual memory write (e.g. this matters
-		// when that command is also a memory write)
-		motherBoard.getScheduler().schedule(time + EmuDuration::epsilon());
 		if (writeWatchSet[address >> CacheLine::BITS]
 		                 [address &  CacheLine::LOW]) {
-			executeMemWatch(WatchPoint::Type::WRITE_MEM, address, value);
+			executeMemWatch(WatchPoint::Type::WRITE_MEM, address, time, value);
 		}
 	}
 }
@@ -876,6 +908,18 @@ void MSXCPUInterface::setWatchPoint(const std::shared_ptr<WatchPoint>& watchPoin
 	}
 }
 
+// Remove 'watch' from the chain of MSXWatchIODevices starting at 'devicePtr'.
+static void unlinkWatchIODevice(MSXDevice*& devicePtr, MSXWatchIODevice& watch)
+{
+	// find pointer to watch device
+	MSXDevice** prev = &devicePtr;
+	while (*prev != &watch) {
+		prev = &checked_cast<MSXWatchIODevice*>(*prev)->getDevicePtr();
+	}
+	// remove it from the chain
+	*prev = watch.getDevicePtr();
+}
+
 static void unregisterIOWatch(WatchPoint& watchPoint, std::span<MSXDevice*, 256> devices)
 {
 	auto& ioWatch = checked_cast<WatchIO&>(watchPoint);
@@ -885,13 +929,7 @@ static void unregisterIOWatch(WatchPoint& watchPoint, std::span<MSXDevice*, 256>
 	assert(endPort < 0x100);
 
 	for (unsigned port = beginPort; port <= endPort; ++port) {
-		// find pointer to watchpoint
-		MSXDevice** prev = &devices[port];
-		while (*prev != &ioWatch.getDevice(narrow_cast<byte>(port))) {
-			prev = &checked_cast<MSXWatchIODevice*>(*prev)->getDevicePtr();
-		}
-		// remove watchpoint from chain
-		*prev = checked_cast<MSXWatchIODevice*>(*prev)->getDevicePtr();
+		unlinkWatchIODevice(devices[port], ioWatch.getDevice(narrow_cast<byte>(port)));
 	}
 }
 
@@ -989,11 +1027,86 @@ void MSXCPUInterface::updateMemWatch(WatchPoint::Type type)
 	msxcpu.invalidateAllSlotsRWCache(0x0000, 0x10000);
 }
 
+void MSXCPUInterface::setHeatMapIO(
+	std::unique_ptr<HeatMapIO>& counter, bool enable,
+	HeatMap::Type type, std::span<MSXDevice*, 256> devices)
+{
+	if (enable == bool(counter)) return;
+	if (enable) {
+		counter = std::make_unique<HeatMapIO>(
+			heatMap, type, *motherBoard.getMachineConfig());
+		for (auto port : xrange(256)) {
+			auto& watch = *counter->devices[port];
+			watch.getDevicePtr() = devices[port];
+			devices[port] = &watch;
+		}
+	} else {
+		for (auto port : xrange(256)) {
+			unlinkWatchIODevice(devices[port], *counter->devices[port]);
+		}
+		counter.reset();
+	}
+}
+
+void MSXCPUInterface::updateHeatMap()
+{
+	setHeatMapIO(heatMapIn,  heatMap.isEnabled(HeatMap::Type::IN),  HeatMap::Type::IN,  IO_In);
+	setHeatMapIO(heatMapOut, heatMap.isEnabled(HeatMap::Type::OUT), HeatMap::Type::OUT, IO_Out);
+
+	// Counting reads or writes requires that all accesses go through
+	// readMemSlow() / writeMemSlow(), so disable the CPU memory caches.
+	bool read  = heatMap.isEnabled(HeatMap::Type::READ);
+	bool write = heatMap.isEnabled(HeatMap::Type::WRITE);
+	if (read  == bool(disallowReadCache [0] & HEATMAP_BIT) &&
+	    write == bool(disallowWriteCache[0] & HEATMAP_BIT)) {
+		return; // no change
+	}
+	for (auto i : xrange(CacheLine::NUM)) {
+		if (read) {
+			disallowReadCache [i] |=  HEATMAP_BIT;
+		} else {
+			disallowReadCache [i] &= ~HEATMAP_BIT;
+		}
+		if (write) {
+			disallowWriteCache[i] |=  HEATMAP_BIT;
+		} else {
+			disallowWriteCache[i] &= ~HEATMAP_BIT;
+		}
+	}
+	msxcpu.invalidateAllSlotsRWCache(0x0000, 0x10000);
+}
+
 void MSXCPUInterface::executeMemWatch(WatchPoint::Type type,
-                                      unsigned address, unsigned value)
+                                      unsigned address, EmuTime::param time,
+                                      unsigned value)
 {
 	assert(!watchPoints.empty());
-	if (isFastForward()) return;
+	bool fastForward = isFastForward();
+
+	// First handle the watchpoints in 'log' mode, these don't need Tcl.
+	// Only when there are other matching watchpoints go the slow route.
+	bool needTcl = false;
+	for (auto& w : watchPoints) {
+		if ((w->getBeginAddress() <= address) &&
+		    (w->getEndAddress()   >= address) &&
+		    (w->getType()         == type)) {
+			if (!w->isLogOnly()) {
+				needTcl = true;
+			} else if (!fastForward) {
+				w->addLogEntry(time, address, value, msxcpu.getRegisters().getPC());
+			}
+		}
+	}
+	if (!needTcl) return;
+
+	if (type == WatchPoint::Type::WRITE_MEM) {
+		// Advance time for the tiniest amount, this makes sure that
+		// later on a possible replay we also replay recorded commands
+		// after the actual memory write (e.g. this matters when that
+		// command is also a memory write)
+		motherBoard.getScheduler().schedule(time + EmuDuration::epsilon());
+	}
+	if (fastForward) return;
 
 	auto& globalCliComm = motherBoard.getReactor().getGlobalCliComm();
 	auto& interp        = motherBoard.getReactor().getInterpreter();
@@ -1009,7 +1122,8 @@ void MSXCPUInterface::executeMemWatch(WatchPoint::Type type,
 	for (auto& w : wpCopy) {
 		if ((w->getBeginAddress() <= address) &&
 		    (w->getEndAddress()   >= address) &&
-		    (w->getType()         == type)) {
+		    (w->getType()         == type) &&
+		    !w->isLogOnly()) {
 			bool remove = w->checkAndExecute(globalCliComm, interp);
 			if (remove) {
 				removeWatchPoint(w);
@@ -4,6 +4,7 @@
 #include "BreakPoint.hh"
 #include "CacheLine.hh"
 #include "DebugCondition.hh"
+#include "HeatMap.hh"
 #include "WatchPoint.hh"
 
 #include "SimpleDebuggable.hh"
@@ -248,6 +249,11 @@ public:
 
 	[[nodiscard]] DummyDevice& getDummyDevice() { return *dummyDevice; }
 
+	/** Should be called when the set of enabled types in the CPU
+	  * heatmap changed (to enable/disable the memory caches and to
+	  * insert/remove the IO port counters). */
+	void updateHeatMap();
+
 	void insertBreakPoint(BreakPoint bp);
 	void removeBreakPoint(const BreakPoint& bp);
 	void removeBreakPoint(unsigned id);
@@ -326,7 +332,7 @@ private:
 	void removeAllWatchPoints();
 	void updateMemWatch(WatchPoint::Type type);
 	void executeMemWatch(WatchPoint::Type type, unsigned address,
-	                     unsigned value = ~0u);
+	                     EmuTime::param time, unsigned value = ~0u);
 
 	struct MemoryDebug final : SimpleDebuggable {
 		explicit MemoryDebug(MSXMotherBoard& motherBoard);
@@ -398,14 +404,25 @@ private:
 	inline void updateVisible(byte page, byte ps, byte ss);
 	void setSubSlot(byte primSlot, byte value);
 
+	struct HeatMapIO;
+	void setHeatMapIO(std::unique_ptr<HeatMapIO>& counter, bool enable,
+	                  HeatMap::Type type, std::span<MSXDevice*, 256> devices);
+
 	std::unique_ptr<DummyDevice> dummyDevice;
 	MSXCPU& msxcpu;
+	HeatMap& heatMap;
 	CliComm& cliComm;
 	MSXMotherBoard& motherBoard;
 	BooleanSetting& pauseSetting;
 
 	std::unique_ptr<VDPIODelay> delayDevice; // can be nullptr
 
+	// Counters for the IO heatmap. Like IO watchpoints these are inserted
+	// in front of the devices in IO_In/IO_Out, so they cost nothing when
+	// disabled. nullptr when disabled.
+	std::unique_ptr<HeatMapIO> heatMapIn;
+	std::unique_ptr<HeatMapIO> heatMapOut;
+
 	std::array<byte, CacheLine::NUM> disallowReadCache;
 	std::array<byte, CacheLine::NUM> disallowWriteCache;
 	std::array<std::bitset<CacheLine::SIZE>, CacheLine::NUM> readWatchSet;
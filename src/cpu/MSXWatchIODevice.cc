@@ -1,6 +1,8 @@
 #include "MSXWatchIODevice.hh"
 
+#include "CPURegs.hh"
 #include "Interpreter.hh"
+#include "MSXCPU.hh"
 #include "MSXCPUInterface.hh"
 #include "MSXMotherBoard.hh"
 #include "Reactor.hh"
@@ -36,11 +38,16 @@ MSXWatchIODevice& WatchIO::getDevice(byte port)
 	return *ios[port - begin];
 }
 
-void WatchIO::doReadCallback(unsigned port)
+void WatchIO::doReadCallback(unsigned port, EmuTime::param time)
 {
 	auto& cpuInterface = motherboard.getCPUInterface();
 	if (cpuInterface.isFastForward()) return;
 
+	if (isLogOnly()) {
+		addLogEntry(time, port, ~0u, motherboard.getCPU().getRegisters().getPC());
+		return;
+	}
+
 	auto& cliComm = motherboard.getReactor().getGlobalCliComm();
 	auto& interp  = motherboard.getReactor().getInterpreter();
 	interp.setVariable(TclObject("wp_last_address"), TclObject(int(port)));
@@ -56,11 +63,16 @@ void WatchIO::doReadCallback(unsigned port)
 	interp.unsetVariable("wp_last_address");
 }
 
-void WatchIO::doWriteCallback(unsigned port, unsigned value)
+void WatchIO::doWriteCallback(unsigned port, unsigned value, EmuTime::param time)
 {
 	auto& cpuInterface = motherboard.getCPUInterface();
 	if (cpuInterface.isFastForward()) return;
 
+	if (isLogOnly()) {
+		addLogEntry(time, port, value, motherboard.getCPU().getRegisters().getPC());
+		return;
+	}
+
 	auto& cliComm = motherboard.getReactor().getGlobalCliComm();
 	auto& interp  = motherboard.getReactor().getInterpreter();
 	interp.setVariable(TclObject("wp_last_address"), TclObject(int(port)));
@@ -81,9 +93,9 @@ void WatchIO::doWriteCallback(unsigned port, unsigned value)
 // class MSXWatchIODevice
 
 MSXWatchIODevice::MSXWatchIODevice(
-		const HardwareConfig& hwConf, WatchIO& watchIO_)
+		const HardwareConfig& hwConf, IOWatcher& watcher_)
 	: MSXMultiDevice(hwConf)
-	, watchIO(watchIO_)
+	, watcher(watcher_)
 {
 }
 
@@ -104,7 +116,7 @@ byte MSXWatchIODevice::readIO(word port, EmuTime::param time)
 	assert(device);
 
 	// first trigger watchpoint, then read from device
-	watchIO.doReadCallback(port);
+	watcher.doReadCallback(port, time);
 	return device->readIO(port, time);
 }
 
@@ -114,7 +126,7 @@ void MSXWatchIODevice::writeIO(word port, byte value, EmuTime::param time)
 
 	// first write to device, then trigger watchpoint
 	device->writeIO(port, value, time);
-	watchIO.doWriteCallback(port, value);
+	watcher.doWriteCallback(port, value, time);
 }
 
 } // namespace openmsx
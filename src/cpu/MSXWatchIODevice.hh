@@ -9,7 +9,21 @@ namespace openmsx {
 
 class MSXWatchIODevice;
 
+/** Gets notified about the accesses to the IO ports it is registered on
+  * (via MSXWatchIODevice).
+  */
+class IOWatcher
+{
+public:
+	virtual void doReadCallback(unsigned port, EmuTime::param time) = 0;
+	virtual void doWriteCallback(unsigned port, unsigned value, EmuTime::param time) = 0;
+
+protected:
+	~IOWatcher() = default;
+};
+
 class WatchIO final : public WatchPoint
+                    , public IOWatcher
                     , public std::enable_shared_from_this<WatchIO>
 {
 public:
@@ -22,20 +36,19 @@ public:
 	MSXWatchIODevice& getDevice(byte port);
 
 private:
-	void doReadCallback(unsigned port);
-	void doWriteCallback(unsigned port, unsigned value);
+	// IOWatcher
+	void doReadCallback(unsigned port, EmuTime::param time) override;
+	void doWriteCallback(unsigned port, unsigned value, EmuTime::param time) override;
 
 private:
 	MSXMotherBoard& motherboard;
 	std::vector<std::unique_ptr<MSXWatchIODevice>> ios;
-
-	friend class MSXWatchIODevice;
 };
 
 class MSXWatchIODevice final : public MSXMultiDevice
 {
 public:
-	MSXWatchIODevice(const HardwareConfig& hwConf, WatchIO& watchIO);
+	MSXWatchIODevice(const HardwareConfig& hwConf, IOWatcher& watcher);
 
 	[[nodiscard]] MSXDevice*& getDevicePtr() { return device; }
 
@@ -47,7 +60,7 @@ private:
 	void writeIO(word port, byte value, EmuTime::param time) override;
 
 private:
-	WatchIO& watchIO;
+	IOWatcher& watcher;
 	MSXDevice* device = nullptr;
 };
 
@@ -2,7 +2,11 @@
 #define WATCHPOINT_HH
 
 #include "BreakPointBase.hh"
+#include "EmuTime.hh"
 #include <cassert>
+#include <cstdint>
+#include <utility>
+#include <vector>
 
 namespace openmsx {
 
@@ -15,6 +19,19 @@ class WatchPoint : public BreakPointBase
 public:
 	enum class Type { READ_IO, WRITE_IO, READ_MEM, WRITE_MEM };
 
+	/** A watchpoint in 'log' mode doesn't evaluate its condition and
+	  * command (in Tcl). Instead it only records the accesses, these can
+	  * later be retrieved via takeLog(). At most MAX_LOG_SIZE accesses are
+	  * kept, further accesses are only counted, see takeLogOverflow().
+	  */
+	struct LogEntry {
+		EmuTime time;
+		unsigned address;
+		unsigned value; // ~0u for reads
+		uint16_t pc;
+	};
+	static constexpr size_t MAX_LOG_SIZE = 1024 * 1024;
+
 	/** Begin and end address are inclusive (IOW range = [begin, end])
 	 */
 	WatchPoint(TclObject command_, TclObject condition_,
@@ -34,11 +51,38 @@ public:
 	[[nodiscard]] unsigned getBeginAddress() const { return beginAddr; }
 	[[nodiscard]] unsigned getEndAddress()   const { return endAddr; }
 
+	[[nodiscard]] bool isLogOnly() const { return logOnly; }
+	void setLogOnly(bool b) { logOnly = b; }
+
+	void addLogEntry(EmuTime::param time, unsigned address, unsigned value, uint16_t pc) {
+		if (log.size() < MAX_LOG_SIZE) [[likely]] {
+			log.push_back(LogEntry{time, address, value, pc});
+		} else {
+			++logOverflow;
+		}
+	}
+	[[nodiscard]] std::vector<LogEntry> takeLog() {
+		return std::exchange(log, {});
+	}
+	/** Number of accesses that were not recorded because the log was
+	  * full (since the previous call). */
+	[[nodiscard]] size_t takeLogOverflow() {
+		return std::exchange(logOverflow, 0);
+	}
+	/** Move the not yet retrieved log of 'other' to this watchpoint. */
+	void takeLogFrom(WatchPoint& other) {
+		log = other.takeLog();
+		logOverflow = other.takeLogOverflow();
+	}
+
 private:
 	unsigned id;
 	unsigned beginAddr;
 	unsigned endAddr;
 	Type type;
+	bool logOnly = false;
+	std::vector<LogEntry> log;
+	size_t logOverflow = 0;
 
 	static inline unsigned lastId = 0;
 };
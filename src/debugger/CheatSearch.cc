@@ -0,0 +1,158 @@
+#include "CheatSearch.hh"
+
+#include "narrow.hh"
+#include "ranges.hh"
+#include "xrange.hh"
+
+#include <algorithm>
+#include <bit>
+#include <cassert>
+#include <functional>
+#include <limits>
+
+namespace openmsx {
+
+static constexpr size_t BITS = 64;
+
+void CheatSearch::start(std::span<const uint8_t> snapshot, bool word_)
+{
+	word = word_;
+	snapshotSize = snapshot.size();
+	current.assign(snapshot.begin(), snapshot.end());
+	previous = current;
+	candidates.assign((numAddresses() + BITS - 1) / BITS, ~uint64_t(0));
+	clearTail();
+}
+
+void CheatSearch::update(std::span<const uint8_t> snapshot)
+{
+	takeSnapshot(snapshot);
+}
+
+void CheatSearch::filter(std::span<const uint8_t> snapshot, Op op, std::optional<unsigned> value)
+{
+	takeSnapshot(snapshot);
+	if (word) {
+		narrowDown<uint16_t>(op, value);
+	} else {
+		narrowDown<uint8_t>(op, value);
+	}
+}
+
+void CheatSearch::keep(std::span<const unsigned> addresses)
+{
+	std::vector<uint64_t> selected(candidates.size());
+	for (auto addr : addresses) {
+		if (addr >= numAddresses()) continue;
+		selected[addr / BITS] |= uint64_t(1) << (addr % BITS);
+	}
+	for (auto i : xrange(candidates.size())) candidates[i] &= selected[i];
+}
+
+size_t CheatSearch::count() const
+{
+	size_t result = 0;
+	for (auto w : candidates) result += std::popcount(w);
+	return result;
+}
+
+std::vector<CheatSearch::Result> CheatSearch::getResults(size_t max) const
+{
+	std::vector<Result> result;
+	for (auto w : xrange(candidates.size())) {
+		auto bits = candidates[w];
+		while (bits) {
+			if (result.size() == max) return result;
+			auto addr = w * BITS + std::countr_zero(bits);
+			result.push_back({narrow<unsigned>(addr),
+			                  getValue(previous, addr),
+			                  getValue(current, addr)});
+			bits &= bits - 1;
+		}
+	}
+	return result;
+}
+
+size_t CheatSearch::numAddresses() const
+{
+	// a 16-bit value can't start at the last address
+	return (word && snapshotSize) ? snapshotSize - 1 : snapshotSize;
+}
+
+template<typename T>
+static T load(const uint8_t* p)
+{
+	if constexpr (sizeof(T) == 1) {
+		return p[0];
+	} else {
+		return T(p[0] | (p[1] << 8));
+	}
+}
+
+unsigned CheatSearch::getValue(const std::vector<uint8_t>& buf, size_t addr) const
+{
+	return word ? load<uint16_t>(&buf[addr]) : load<uint8_t>(&buf[addr]);
+}
+
+void CheatSearch::takeSnapshot(std::span<const uint8_t> snapshot)
+{
+	assert(isStarted());
+	assert(snapshot.size() == snapshotSize);
+	std::swap(previous, current);
+	ranges::copy(snapshot, current);
+}
+
+void CheatSearch::clearTail()
+{
+	if (auto rest = numAddresses() % BITS) {
+		candidates.back() &= (uint64_t(1) << rest) - 1;
+	}
+}
+
+// Process the candidates in blocks of 64 addresses. Blocks without any
+// candidate left are skipped as a whole. The inner loop has no data
+// dependent branches, so the compiler can vectorize it.
+template<typename T, typename Compare>
+void CheatSearch::narrowDown(Compare cmp)
+{
+	auto num = numAddresses();
+	const auto* newData = current.data();
+	const auto* oldData = previous.data();
+	for (auto w : xrange(candidates.size())) {
+		auto bits = candidates[w];
+		if (bits == 0) continue;
+		auto base = w * BITS;
+		auto n = std::min(BITS, num - base);
+		uint64_t mask = 0;
+		for (auto i : xrange(n)) {
+			auto addr = base + i;
+			bool keepIt = cmp(load<T>(&newData[addr]), load<T>(&oldData[addr]));
+			mask |= uint64_t(keepIt) << i;
+		}
+		candidates[w] = bits & mask;
+	}
+}
+
+template<typename T>
+void CheatSearch::narrowDown(Op op, std::optional<unsigned> value)
+{
+	auto compare = [&](auto cmp) {
+		if (value) {
+			assert(*value <= std::numeric_limits<T>::max());
+			auto v = T(*value);
+			narrowDown<T>([&](T newVal, T /*oldVal*/) { return cmp(newVal, v); });
+		} else {
+			narrowDown<T>(cmp);
+		}
+	};
+	switch (op) {
+		case Op::LT: compare(std::less<T>{});          break;
+		case Op::LE: compare(std::less_equal<T>{});    break;
+		case Op::NE: compare(std::not_equal_to<T>{});  break;
+		case Op::EQ: compare(std::equal_to<T>{});      break;
+		case Op::GE: compare(std::greater_equal<T>{}); break;
+		case Op::GT: compare(std::greater<T>{});       break;
+	}
+}
+
+} // namespace openmsx
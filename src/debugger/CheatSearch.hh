@@ -0,0 +1,73 @@
+#ifndef CHEATSEARCH_HH
+#define CHEATSEARCH_HH
+
+#include <cstdint>
+#include <optional>
+#include <span>
+#include <vector>
+
+namespace openmsx {
+
+/** Native engine behind the cheat finder.
+  *
+  * It keeps the two most recent snapshots of a debuggable, and a bitset with
+  * one bit per address that is still a candidate. Each narrowing pass
+  * compares the new snapshot with the previous one (or with a constant
+  * value) for all candidates in one go. Values are either 8-bit or 16-bit
+  * (little endian, starting at each address).
+  */
+class CheatSearch
+{
+public:
+	enum class Op : uint8_t { LT, LE, NE, EQ, GE, GT };
+
+	struct Result {
+		unsigned address;
+		unsigned oldValue;
+		unsigned newValue;
+	};
+
+	/** Restart the search: all addresses become candidates again. */
+	void start(std::span<const uint8_t> snapshot, bool word);
+
+	/** Take a new snapshot, without narrowing the candidates. */
+	void update(std::span<const uint8_t> snapshot);
+
+	/** Take a new snapshot and only keep the candidates for which
+	  * 'new <op> old' holds, or 'new <op> value' when a value is given.
+	  */
+	void filter(std::span<const uint8_t> snapshot, Op op, std::optional<unsigned> value);
+
+	/** Only keep the candidates that are also in the given list. */
+	void keep(std::span<const unsigned> addresses);
+
+	[[nodiscard]] bool isStarted() const { return !current.empty(); }
+	[[nodiscard]] bool isWord() const { return word; }
+	[[nodiscard]] size_t size() const { return snapshotSize; }
+	[[nodiscard]] size_t count() const;
+
+	/** The first (at most) 'max' remaining candidates, ordered by address. */
+	[[nodiscard]] std::vector<Result> getResults(size_t max) const;
+
+private:
+	[[nodiscard]] size_t numAddresses() const;
+	[[nodiscard]] unsigned getValue(const std::vector<uint8_t>& buf, size_t addr) const;
+	void takeSnapshot(std::span<const uint8_t> snapshot);
+	void clearTail();
+
+	template<typename T, typename Compare>
+	void narrowDown(Compare cmp);
+	template<typename T>
+	void narrowDown(Op op, std::optional<unsigned> value);
+
+private:
+	std::vector<uint8_t> previous;
+	std::vector<uint8_t> current;
+	std::vector<uint64_t> candidates; // 1 bit per address
+	size_t snapshotSize = 0;
+	bool word = false;
+};
+
+} // namespace openmsx
+
+#endif
@@ -2,6 +2,7 @@
 #define DEBUGGABLE_HH
 
 #include "openmsx.hh"
+#include <span>
 #include <string_view>
 
 namespace openmsx {
@@ -19,6 +20,19 @@ public:
 	[[nodiscard]] virtual byte read(unsigned address) = 0;
 	virtual void write(unsigned address, byte value) = 0;
 
+	/** Read/write a contiguous range of bytes, starting at 'address'.
+	  * The caller must make sure the whole range lies within
+	  * [0, getSize()). The default implementations simply loop over
+	  * read()/write(), subclasses can override them to copy the whole
+	  * block at once (e.g. a memcpy() for debuggables backed by RAM).
+	  */
+	virtual void readBlock(unsigned address, std::span<byte> output) {
+		for (unsigned i = 0; auto& b : output) b = read(address + i++);
+	}
+	virtual void writeBlock(unsigned address, std::span<const byte> input) {
+		for (unsigned i = 0; auto b : input) write(address + i++, b);
+	}
+
 protected:
 	Debuggable() = default;
 	~Debuggable() = default;
@@ -39,6 +39,7 @@ Debugger::Debugger(MSXMotherBoard& motherBoard_)
 	, cmd(motherBoard.getCommandController(),
 	      motherBoard.getStateChangeDistributor(),
 	      motherBoard.getScheduler())
+	, trainer(motherBoard)
 {
 }
 
@@ -155,7 +156,7 @@ void Debugger::removeProbeBreakPoint(ProbeBreakPoint& bp)
 unsigned Debugger::setWatchPoint(TclObject command, TclObject condition,
                                  WatchPoint::Type type,
                                  unsigned beginAddr, unsigned endAddr,
-                                 bool once, unsigned newId /*= -1*/)
+                                 bool once, bool logOnly, unsigned newId /*= -1*/)
 {
 	std::shared_ptr<WatchPoint> wp;
 	if (type == one_of(WatchPoint::Type::READ_IO, WatchPoint::Type::WRITE_IO)) {
@@ -166,6 +167,7 @@ unsigned Debugger::setWatchPoint(TclObject command, TclObject condition,
 		wp = std::make_shared<WatchPoint>(
 			std::move(command), std::move(condition), type, beginAddr, endAddr, once, newId);
 	}
+	wp->setLogOnly(logOnly);
 	motherBoard.getCPUInterface().setWatchPoint(wp);
 	return wp->getId();
 }
@@ -175,10 +177,15 @@ void Debugger::transfer(Debugger& other)
 	// Copy watchpoints to new machine.
 	assert(motherBoard.getCPUInterface().getWatchPoints().empty());
 	for (const auto& wp : other.motherBoard.getCPUInterface().getWatchPoints()) {
-		setWatchPoint(wp->getCommandObj(), wp->getConditionObj(),
-		              wp->getType(),       wp->getBeginAddress(),
-		              wp->getEndAddress(), wp->onlyOnce(),
-		              wp->getId());
+		auto id = setWatchPoint(wp->getCommandObj(), wp->getConditionObj(),
+		                        wp->getType(),       wp->getBeginAddress(),
+		                        wp->getEndAddress(), wp->onlyOnce(),
+		                        wp->isLogOnly(), wp->getId());
+		// also keep the not yet retrieved accesses of a -log watchpoint
+		const auto& newWps = motherBoard.getCPUInterface().getWatchPoints();
+		auto it = ranges::find(newWps, id, &WatchPoint::getId);
+		assert(it != newWps.end());
+		(*it)->takeLogFrom(*wp);
 	}
 
 	// Copy probes to new machine.
@@ -192,6 +199,10 @@ void Debugger::transfer(Debugger& other)
 		}
 	}
 
+	// The trainer is not copied: it's part of the machine state (see
+	// MSXMotherBoard::serialize()), so the new machine already has the
+	// trainer that was active at the moment of the snapshot.
+
 	// Breakpoints and conditions are (currently) global, so no need to
 	// copy those.
 }
@@ -218,11 +229,16 @@ Debugger::Cmd::Cmd(CommandController& commandController_,
 
 bool Debugger::Cmd::needRecord(std::span<const TclObject> tokens) const
 {
-	// Note: it's crucial for security that only the write and write_block
-	// subcommands are recorded and replayed. The 'set_bp' command for
-	// example would allow to set a callback that can execute arbitrary Tcl
-	// code. See comments in RecordedCommand for more details.
+	// Note: it's crucial for security that only the write, write_block
+	// and trainer subcommands are recorded and replayed. The 'set_bp'
+	// command for example would allow to set a callback that can execute
+	// arbitrary Tcl code. See comments in RecordedCommand for more details.
+	// The trainer only pokes memory (like 'write'), but it does so
+	// periodically, so (de)activating it must be recorded instead.
 	if (tokens.size() < 2) return false;
+	if (tokens[1] == "trainer") {
+		return (tokens.size() > 2) && (tokens[2] == one_of("set", "clear"));
+	}
 	return tokens[1].getString() == one_of("write", "write_block");
 }
 
@@ -249,10 +265,14 @@ void Debugger::Cmd::execute(
 		"set_watchpoint",    [&]{ setWatchPoint(tokens, result); },
 		"remove_watchpoint", [&]{ removeWatchPoint(tokens, result); },
 		"list_watchpoints",  [&]{ listWatchPoints(tokens, result); },
+		"watchpoint_log",    [&]{ watchPointLog(tokens, result); },
 		"set_condition",     [&]{ setCondition(tokens, result); },
 		"remove_condition",  [&]{ removeCondition(tokens, result); },
 		"list_conditions",   [&]{ listConditions(tokens, result); },
 		"probe",             [&]{ probe(tokens, result); },
+		"cheat_search",      [&]{ cheatSearch(tokens, result); },
+		"trainer",           [&]{ trainer(tokens, result); },
+		"umr_log",           [&]{ umrLog(tokens, result); },
 		"symbols",           [&]{ symbols(tokens, result); });
 }
 
@@ -302,10 +322,9 @@ void Debugger::Cmd::readBlock(std::span<const TclObject> tokens, TclObject& resu
 	}
 
 	MemBuffer<byte> buf(num);
-	for (auto i : xrange(num)) {
-		buf[i] = device.read(addr + i);
-	}
-	result = std::span<byte>{buf.data(), num};
+	std::span<byte> block{buf.data(), num};
+	device.readBlock(addr, block);
+	result = block;
 }
 
 void Debugger::Cmd::write(std::span<const TclObject> tokens, TclObject& /*result*/)
@@ -339,9 +358,7 @@ void Debugger::Cmd::writeBlock(std::span<const TclObject> tokens, TclObject& /*r
 		throw CommandException("Invalid size");
 	}
 
-	for (auto i : xrange(buf.size())) {
-		device.write(unsigned(addr + i), buf[i]);
-	}
+	device.writeBlock(addr, buf);
 }
 
 void Debugger::Cmd::setBreakPoint(std::span<const TclObject> tokens, TclObject& result)
@@ -424,14 +441,15 @@ void Debugger::Cmd::listBreakPoints(std::span<const TclObject> /*tokens*/, TclOb
 
 void Debugger::Cmd::setWatchPoint(std::span<const TclObject> tokens, TclObject& result)
 {
-	checkNumArgs(tokens, AtLeast{4}, Prefix{2}, "type address ?-once? ?condition? ?command?");
+	checkNumArgs(tokens, AtLeast{4}, Prefix{2}, "type address ?-once? ?-log? ?condition? ?command?");
 	TclObject command("debug break");
 	TclObject condition;
 	unsigned beginAddr, endAddr;
 	WatchPoint::Type type;
 	bool once = false;
+	bool logOnly = false;
 
-	std::array info = {flagArg("-once", once)};
+	std::array info = {flagArg("-once", once), flagArg("-log", logOnly)};
 	auto arguments = parseTclArgs(getInterpreter(), tokens.subspan(2), info);
 	if ((arguments.size() < 2) || (arguments.size() > 4)) {
 		throw SyntaxError();
@@ -485,10 +503,44 @@ void Debugger::Cmd::setWatchPoint(std::span<const TclObject> tokens, TclObject&
 		UNREACHABLE;
 	}
 	unsigned id = debugger().setWatchPoint(
-		command, condition, type, beginAddr, endAddr, once);
+		command, condition, type, beginAddr, endAddr, once, logOnly);
 	result = tmpStrCat("wp#", id);
 }
 
+void Debugger::Cmd::watchPointLog(
+	std::span<const TclObject> tokens, TclObject& result)
+{
+	checkNumArgs(tokens, 3, "id");
+	string_view tmp = tokens[2].getString();
+	if (tmp.starts_with("wp#")) {
+		if (auto id = StringOp::stringToBase<10, unsigned>(tmp.substr(3))) {
+			auto& interface = debugger().motherBoard.getCPUInterface();
+			for (auto& wp : interface.getWatchPoints()) {
+				if (wp->getId() == *id) {
+					// report time in the same way as 'machine_info time'
+					auto reset = debugger().cpu->getResetTime();
+					for (const auto& e : wp->takeLog()) {
+						double t = (e.time >= reset) ?  (e.time - reset).toDouble()
+						                             : -(reset - e.time).toDouble();
+						result.addListElement(
+							t,
+							int(e.address),
+							(e.value == ~0u) ? -1 : int(e.value),
+							int(e.pc));
+					}
+					if (auto dropped = wp->takeLogOverflow()) {
+						debugger().motherBoard.getMSXCliComm().printWarning(
+							"Log of ", tmp, " was full, ", dropped,
+							" accesses were not recorded.");
+					}
+					return;
+				}
+			}
+		}
+	}
+	throw CommandException("No such watchpoint: ", tmp);
+}
+
 void Debugger::Cmd::removeWatchPoint(
 	std::span<const TclObject> tokens, TclObject& /*result*/)
 {
@@ -546,6 +598,7 @@ void Debugger::Cmd::listWatchPoints(
 		}
 		line.addListElement(wp->getCondition(),
 		                    wp->getCommand());
+		if (wp->isLogOnly()) line.addListElement("-log");
 		strAppend(res, line.getString(), '\n');
 	}
 	result = res;
@@ -696,6 +749,194 @@ SymbolManager& Debugger::Cmd::getSymbolManager()
 {
 	return debugger().getMotherBoard().getReactor().getSymbolManager();
 }
+
+static CheatSearch::Op parseCheatSearchOp(std::string_view str)
+{
+	using enum CheatSearch::Op;
+	if (str == "<")  return LT;
+	if (str == "<=") return LE;
+	if (str == "!=") return NE;
+	if (str == "==") return EQ;
+	if (str == ">=") return GE;
+	if (str == ">")  return GT;
+	throw CommandException("Invalid operator: ", str);
+}
+
+void Debugger::Cmd::cheatSearch(std::span<const TclObject> tokens, TclObject& result)
+{
+	checkNumArgs(tokens, AtLeast{3}, "subcommand ?arg ...?");
+	auto& interp = getInterpreter();
+	auto& search = debugger().cheatSearch;
+	auto getSnapshot = [&](Debuggable& device) {
+		MemBuffer<byte> buf(device.getSize());
+		device.readBlock(0, std::span{buf.data(), device.getSize()});
+		return buf;
+	};
+	auto checkStarted = [&] {
+		if (!search.isStarted()) {
+			throw CommandException("No cheat search started");
+		}
+	};
+	auto getCurrentDevice = [&]() -> Debuggable& {
+		checkStarted();
+		const auto& name = debugger().cheatSearchDebuggable;
+		auto* device = debugger().findDebuggable(name);
+		if (!device || (device->getSize() != search.size())) {
+			throw CommandException("Debuggable '", name, "' is no longer available");
+		}
+		return *device;
+	};
+	executeSubCommand(tokens[2].getString(),
+		"start", [&]{
+			checkNumArgs(tokens, Between{4, 5}, Prefix{3}, "debuggable ?-word?");
+			bool words = false;
+			if (tokens.size() == 5) {
+				if (tokens[4] != "-word") {
+					throw CommandException("Invalid option: ", tokens[4].getString());
+				}
+				words = true;
+			}
+			auto name = tokens[3].getString();
+			auto& device = debugger().getDebuggable(name);
+			auto buf = getSnapshot(device);
+			search.start(std::span{buf.data(), device.getSize()}, words);
+			debugger().cheatSearchDebuggable = name;
+			result = narrow<int>(search.count());
+		},
+		"update", [&]{
+			checkNumArgs(tokens, 3, "");
+			auto& device = getCurrentDevice();
+			auto buf = getSnapshot(device);
+			search.update(std::span{buf.data(), device.getSize()});
+			result = narrow<int>(search.count());
+		},
+		"filter", [&]{
+			checkNumArgs(tokens, Between{4, 5}, Prefix{3}, "operator ?value?");
+			auto op = parseCheatSearchOp(tokens[3].getString());
+			auto& device = getCurrentDevice();
+			std::optional<unsigned> value;
+			if (tokens.size() == 5) {
+				auto v = tokens[4].getInt(interp);
+				if ((v < 0) || (v > (search.isWord() ? 0xffff : 0xff))) {
+					throw CommandException("Value out of range: ", v);
+				}
+				value = unsigned(v);
+			}
+			auto buf = getSnapshot(device);
+			search.filter(std::span{buf.data(), device.getSize()}, op, value);
+			result = narrow<int>(search.count());
+		},
+		"keep", [&]{
+			checkNumArgs(tokens, 4, "addresses");
+			checkStarted();
+			auto list = tokens[3];
+			auto addresses = to_vector(view::transform(xrange(list.getListLength(interp)),
+				[&](auto i) { return unsigned(list.getListIndex(interp, i).getInt(interp)); }));
+			search.keep(addresses);
+			result = narrow<int>(search.count());
+		},
+		"count", [&]{
+			checkNumArgs(tokens, 3, "");
+			checkStarted();
+			result = narrow<int>(search.count());
+		},
+		"results", [&]{
+			checkNumArgs(tokens, Between{3, 4}, "?max?");
+			checkStarted();
+			size_t max = (tokens.size() == 4) ? size_t(std::max(0, tokens[3].getInt(interp)))
+			                                  : std::numeric_limits<size_t>::max();
+			for (const auto& r : search.getResults(max)) {
+				result.addListElement(makeTclList(r.address, r.oldValue, r.newValue));
+			}
+		});
+}
+
+void Debugger::Cmd::trainer(std::span<const TclObject> tokens, TclObject& result)
+{
+	checkNumArgs(tokens, AtLeast{3}, "subcommand ?arg ...?");
+	auto& interp = getInterpreter();
+	auto& engine = debugger().trainer;
+	executeSubCommand(tokens[2].getString(),
+		"set", [&]{
+			checkNumArgs(tokens, 5, Prefix{3}, "period actions");
+			std::optional<EmuDuration> period;
+			if (tokens[3] != "frame") {
+				auto seconds = tokens[3].getDouble(interp);
+				if (seconds <= 0.0) {
+					throw CommandException("Period must be positive: ", seconds);
+				}
+				period = EmuDuration(seconds);
+			}
+			std::vector<Trainer::Action> actions;
+			const auto& list = tokens[4];
+			for (auto i : xrange(list.getListLength(interp))) {
+				auto elem = list.getListIndex(interp, i);
+				auto len = elem.getListLength(interp);
+				if ((len < 3) || (len > 4)) {
+					throw CommandException("Invalid trainer action: ", elem.getString(),
+					                       ", expected {debuggable address value ?if_different?}");
+				}
+				Trainer::Action action;
+				auto name = elem.getListIndex(interp, 0).getString();
+				if (name == "slotted memory") {
+					action.slotted = true;
+				} else if (name != "memory") {
+					throw CommandException("Unsupported debuggable: ", name);
+				}
+				auto addr = elem.getListIndex(interp, 1).getInt(interp);
+				if ((addr < 0) || (addr >= (action.slotted ? 0x100000 : 0x10000))) {
+					throw CommandException("Address out of range: ", addr);
+				}
+				action.address = unsigned(addr);
+				auto value = elem.getListIndex(interp, 2).getInt(interp);
+				if ((value < 0) || (value > 255)) {
+					throw CommandException("Value out of range: ", value);
+				}
+				action.value = uint8_t(value);
+				if (len == 4) {
+					auto cond = elem.getListIndex(interp, 3).getString();
+					if (cond != "if_different") {
+						throw CommandException("Invalid condition: ", cond);
+					}
+					action.condition = Trainer::Condition::IF_DIFFERENT;
+				}
+				actions.push_back(action);
+			}
+			engine.set(std::move(actions), period);
+		},
+		"clear", [&]{
+			checkNumArgs(tokens, 3, "");
+			engine.clear();
+		},
+		"status", [&]{
+			checkNumArgs(tokens, 3, "");
+			if (!engine.isActive()) return;
+			const auto& period = engine.getPeriod();
+			result.addDictKeyValues(
+				"period", period ? TclObject(period->toDouble()) : TclObject("frame"),
+				"actions", narrow<int>(engine.getActions().size()));
+		});
+}
+
+void Debugger::Cmd::umrLog(std::span<const TclObject> tokens, TclObject& result)
+{
+	checkNumArgs(tokens, Between{2, 3}, "?clear?");
+	auto& log = debugger().umrLog;
+	if (tokens.size() == 3) {
+		if (tokens[2] != "clear") {
+			throw SyntaxError();
+		}
+		log.clear();
+		return;
+	}
+	const auto& names = log.getRamNames();
+	for (const auto& e : log.getEntries()) {
+		result.addListElement(makeTclList(
+			names[e.ram], narrow<int>(e.address), e.pc,
+			TclObject(Tcl_NewWideIntObj(narrow_cast<Tcl_WideInt>(e.count)))));
+	}
+}
+
 void Debugger::Cmd::symbols(std::span<const TclObject> tokens, TclObject& result)
 {
 	checkNumArgs(tokens, AtLeast{3}, "subcommand ?arg ...?");
@@ -792,10 +1033,14 @@ string Debugger::Cmd::help(std::span<const TclObject> tokens) const
 		"    set_watchpoint    insert a new watchpoint\n"
 		"    remove_watchpoint remove a certain watchpoint\n"
 		"    list_watchpoints  list the active watchpoints\n"
+		"    watchpoint_log    get the accesses recorded by a -log watchpoint\n"
 		"    set_condition     insert a new condition\n"
 		"    remove_condition  remove a certain condition\n"
 		"    list_conditions   list the active conditions\n"
 		"    probe             probe related subcommands\n"
+		"    cheat_search      search for memory locations with a certain value\n"
+		"    trainer           periodically apply memory pokes\n"
+		"    umr_log           get the detected uninitialized memory reads\n"
 		"    cont              continue execution after break\n"
 		"    step              execute one instruction\n"
 		"    break             break CPU at current position\n"
@@ -878,10 +1123,13 @@ string Debugger::Cmd::help(std::span<const TclObject> tokens) const
 		"(default condition is empty). And the last column contains "
 		"the command that will be executed (default is 'debug break').\n";
 	auto setWatchPointHelp =
-		"debug set_watchpoint [-once] <type> <region> [<cond>] [<cmd>]\n"
+		"debug set_watchpoint [-once] [-log] <type> <region> [<cond>] [<cmd>]\n"
 		"  Insert a new watchpoint of given type on the given region, "
 		"there can be an optional -once flag, a condition and alternative "
 		"command. See the 'set_bp' subcommand for details about these.\n"
+		"  With the -log flag the condition and command are ignored. "
+		"Instead every access is only recorded (without going through "
+		"Tcl), see the 'watchpoint_log' subcommand.\n"
 		"  Type must be one of the following:\n"
 		"    read_io    break when CPU reads from given IO port(s)\n"
 		"    write_io   break when CPU writes to given IO port(s)\n"
@@ -904,6 +1152,14 @@ string Debugger::Cmd::help(std::span<const TclObject> tokens) const
 		"debug remove_watchpoint <id>\n"
 		"  Remove the watchpoint with given ID again. You can use the "
 		"'list_watchpoints' subcommand to see all valid IDs.\n";
+	auto watchPointLogHelp =
+		"debug watchpoint_log <id>\n"
+		"  Returns (and clears) the accesses recorded by a watchpoint that "
+		"was created with the -log flag. This is a flat list with 4 values "
+		"per access: the time (in seconds, like 'machine_info time'), the "
+		"address, the value (-1 for reads) and the value of the PC "
+		"register. At most 1048576 accesses are recorded between two "
+		"calls, if more were dropped a warning is printed.\n";
 	auto listWatchPointsHelp =
 		"debug list_watchpoints\n"
 		"  Lists all active watchpoints. The result is similar to the "
@@ -937,6 +1193,43 @@ string Debugger::Cmd::help(std::span<const TclObject> tokens) const
 		"    set_bp <probe> [-once] [<cond>] [<cmd>]  set a breakpoint on the given probe\n"
 		"    remove_bp <id>                           remove the given breakpoint\n"
 		"    list_bp                                  returns a list of breakpoints that are set on probes\n";
+	auto cheatSearchHelp =
+		"debug cheat_search <subcommand> [<arguments>]\n"
+		"  Native engine behind the cheat finder. It remembers the last two "
+		"snapshots of a debuggable and the set of addresses that are still "
+		"candidates. Possible subcommands are:\n"
+		"    start <debuggable> [-word]  take a snapshot, all addresses become candidates again,\n"
+		"                                with -word 16-bit (little endian) values are compared\n"
+		"    filter <op> [<value>]       take a new snapshot and only keep the candidates for\n"
+		"                                which 'new <op> old' (or 'new <op> <value>') holds,\n"
+		"                                <op> is one of: < <= != == >= >\n"
+		"    update                      take a new snapshot without removing candidates\n"
+		"    keep <addresses>            only keep the candidates that are in the given list\n"
+		"    count                       returns the number of remaining candidates\n"
+		"    results [<max>]             returns a list with for each remaining candidate\n"
+		"                                a list {address old-value new-value}\n"
+		"  All subcommands (except 'results') return the number of remaining "
+		"candidates.\n";
+	auto trainerHelp =
+		"debug trainer <subcommand> [<arguments>]\n"
+		"  Native engine behind the 'trainer' command: a table of memory "
+		"pokes that is applied periodically. Possible subcommands are:\n"
+		"    set <period> <actions>  replace the table and apply it right away, <period> is\n"
+		"                            either 'frame' (start of each VDP frame) or a time in\n"
+		"                            seconds, each action is a list\n"
+		"                            {<debuggable> <address> <value> [if_different]}\n"
+		"                            where <debuggable> is 'memory' or 'slotted memory'\n"
+		"    clear                   remove all actions\n"
+		"    status                  dict with the period and the number of actions,\n"
+		"                            empty when no actions are active\n";
+	auto umrLogHelp =
+		"debug umr_log [clear]\n"
+		"  Returns the uninitialized memory reads (UMRs) that were detected "
+		"while the 'umr_check' setting was enabled or an 'umr_callback' was "
+		"set. Each distinct address is reported once, as a list "
+		"{<ram> <address> <pc> <count>} where <pc> is the CPU program counter "
+		"at the first read and <count> the total number of reads.\n"
+		"  With 'clear' the table is emptied.\n";
 	auto contHelp =
 		"debug cont\n"
 		"  Continue execution after CPU was breaked.\n";
@@ -1007,6 +1300,8 @@ string Debugger::Cmd::help(std::span<const TclObject> tokens) const
 		return removeWatchPointHelp;
 	} else if (tokens[1] == "list_watchpoints") {
 		return listWatchPointsHelp;
+	} else if (tokens[1] == "watchpoint_log") {
+		return watchPointLogHelp;
 	} else if (tokens[1] == "set_condition") {
 		return setCondHelp;
 	} else if (tokens[1] == "remove_condition") {
@@ -1015,6 +1310,12 @@ string Debugger::Cmd::help(std::span<const TclObject> tokens) const
 		return listCondHelp;
 	} else if (tokens[1] == "probe") {
 		return probeHelp;
+	} else if (tokens[1] == "cheat_search") {
+		return cheatSearchHelp;
+	} else if (tokens[1] == "trainer") {
+		return trainerHelp;
+	} else if (tokens[1] == "umr_log") {
+		return umrLogHelp;
 	} else if (tokens[1] == "cont") {
 		return contHelp;
 	} else if (tokens[1] == "step") {
@@ -1064,8 +1365,9 @@ void Debugger::Cmd::tabCompletion(std::vector<string>& tokens) const
 	};
 	static constexpr std::array otherCmds = {
 		"disasm"sv, "set_bp"sv, "remove_bp"sv, "set_watchpoint"sv,
-		"remove_watchpoint"sv, "set_condition"sv, "remove_condition"sv,
-		"probe"sv, "symbols"sv,
+		"remove_watchpoint"sv, "watchpoint_log"sv, "set_condition"sv,
+		"remove_condition"sv, "probe"sv, "cheat_search"sv, "trainer"sv,
+		"umr_log"sv, "symbols"sv,
 	};
 	switch (tokens.size()) {
 	case 2: {
@@ -1081,7 +1383,7 @@ void Debugger::Cmd::tabCompletion(std::vector<string>& tokens) const
 			} else if (tokens[1] == "remove_bp") {
 				// this one takes a bp id
 				completeString(tokens, getBreakPointIds());
-			} else if (tokens[1] == "remove_watchpoint") {
+			} else if (tokens[1] == one_of("remove_watchpoint", "watchpoint_log")) {
 				// this one takes a wp id
 				completeString(tokens, getWatchPointIds());
 			} else if (tokens[1] == "remove_condition") {
@@ -1099,6 +1401,20 @@ void Debugger::Cmd::tabCompletion(std::vector<string>& tokens) const
 					"remove_bp"sv, "list_bp"sv,
 				};
 				completeString(tokens, subCmds);
+			} else if (tokens[1] == "cheat_search") {
+				static constexpr std::array subCmds = {
+					"start"sv, "filter"sv, "update"sv, "keep"sv,
+					"count"sv, "results"sv,
+				};
+				completeString(tokens, subCmds);
+			} else if (tokens[1] == "trainer") {
+				static constexpr std::array subCmds = {
+					"set"sv, "clear"sv, "status"sv,
+				};
+				completeString(tokens, subCmds);
+			} else if (tokens[1] == "umr_log") {
+				static constexpr std::array subCmds = {"clear"sv};
+				completeString(tokens, subCmds);
 			} else if (tokens[1] == "symbols") {
 				static constexpr std::array subCmds = {
 					"types"sv, "load"sv, "remove"sv,
@@ -1114,6 +1430,8 @@ void Debugger::Cmd::tabCompletion(std::vector<string>& tokens) const
 			completeString(tokens, view::transform(
 				debugger().probes,
 				[](auto* p) -> std::string_view { return p->getName(); }));
+		} else if ((tokens[1] == "cheat_search") && (tokens[2] == "start")) {
+			completeString(tokens, view::keys(debugger().debuggables));
 		}
 		break;
 	}
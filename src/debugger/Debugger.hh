@@ -1,8 +1,11 @@
 #ifndef DEBUGGER_HH
 #define DEBUGGER_HH
 
+#include "CheatSearch.hh"
 #include "Probe.hh"
 #include "RecordedCommand.hh"
+#include "Trainer.hh"
+#include "UMRLog.hh"
 #include "WatchPoint.hh"
 
 #include "hash_map.hh"
@@ -44,7 +47,7 @@ public:
 	unsigned setWatchPoint(TclObject command, TclObject condition,
 	                       WatchPoint::Type type,
 	                       unsigned beginAddr, unsigned endAddr,
-	                       bool once, unsigned newId = -1);
+	                       bool once, bool logOnly = false, unsigned newId = -1);
 
 	void removeProbeBreakPoint(ProbeBreakPoint& bp);
 	void setCPU(MSXCPU* cpu_) { cpu = cpu_; }
@@ -52,6 +55,8 @@ public:
 	void transfer(Debugger& other);
 
 	[[nodiscard]] MSXMotherBoard& getMotherBoard() { return motherBoard; }
+	[[nodiscard]] UMRLog& getUMRLog() { return umrLog; }
+	[[nodiscard]] Trainer& getTrainer() { return trainer; }
 
 private:
 	[[nodiscard]] Debuggable& getDebuggable(std::string_view name);
@@ -95,6 +100,7 @@ private:
 		void setWatchPoint(std::span<const TclObject> tokens, TclObject& result);
 		void removeWatchPoint(std::span<const TclObject> tokens, TclObject& result);
 		void listWatchPoints(std::span<const TclObject> tokens, TclObject& result);
+		void watchPointLog(std::span<const TclObject> tokens, TclObject& result);
 		void setCondition(std::span<const TclObject> tokens, TclObject& result);
 		void removeCondition(std::span<const TclObject> tokens, TclObject& result);
 		void listConditions(std::span<const TclObject> tokens, TclObject& result) const;
@@ -105,6 +111,9 @@ private:
 		void probeSetBreakPoint(std::span<const TclObject> tokens, TclObject& result);
 		void probeRemoveBreakPoint(std::span<const TclObject> tokens, TclObject& result);
 		void probeListBreakPoints(std::span<const TclObject> tokens, TclObject& result);
+		void cheatSearch(std::span<const TclObject> tokens, TclObject& result);
+		void trainer(std::span<const TclObject> tokens, TclObject& result);
+		void umrLog(std::span<const TclObject> tokens, TclObject& result);
 		void symbols(std::span<const TclObject> tokens, TclObject& result);
 		void symbolsTypes(std::span<const TclObject> tokens, TclObject& result) const;
 		void symbolsLoad(std::span<const TclObject> tokens, TclObject& result);
@@ -122,6 +131,10 @@ private:
 	hash_map<std::string, Debuggable*, XXHasher> debuggables;
 	hash_set<ProbeBase*, NameFromProbe, XXHasher> probes;
 	std::vector<std::unique_ptr<ProbeBreakPoint>> probeBreakPoints; // unordered
+	CheatSearch cheatSearch;
+	std::string cheatSearchDebuggable;
+	Trainer trainer;
+	UMRLog umrLog;
 	MSXCPU* cpu = nullptr;
 };
 
@@ -12,6 +12,7 @@
 #include "StringOp.hh"
 #include "unreachable.hh"
 #include "view.hh"
+#include "xrange.hh"
 
 #include <bit>
 #include <cassert>
@@ -371,7 +372,8 @@ SymbolManager::SymbolManager(CommandController& commandController_)
 void SymbolManager::refresh()
 {
 	// Drop caches
-	lookupValueCache.clear();
+	symbolsByValue.clear();
+	valueIndex.clear();
 
 	// Allow to access symbol-values in Tcl expression with syntax: $sym(JIFFY)
 	auto& interp = commandController.getInterpreter();
@@ -439,18 +441,26 @@ std::optional<uint16_t> SymbolManager::parseSymbolOrValue(std::string_view str)
 
 std::span<Symbol const * const> SymbolManager::lookupValue(uint16_t value)
 {
-	if (lookupValueCache.empty()) {
+	if (valueIndex.empty()) {
 		for (const auto& file : files) {
 			for (const auto& sym : file.symbols) {
-				auto [it, inserted] = lookupValueCache.try_emplace(sym.value, std::vector<const Symbol*>{});
-				it->second.push_back(&sym);
+				symbolsByValue.push_back(&sym);
 			}
 		}
+		// stable: symbols with the same value keep their file order
+		ranges::stable_sort(symbolsByValue.begin(), symbolsByValue.end(), {}, &Symbol::value);
+
+		valueIndex.resize(0x10000 + 1);
+		uint32_t i = 0;
+		for (auto v : xrange(0x10000)) {
+			valueIndex[v] = i;
+			while ((i < symbolsByValue.size()) && (symbolsByValue[i]->value == v)) ++i;
+		}
+		valueIndex[0x10000] = i;
 	}
-	if (auto* sym = lookup(lookupValueCache, value)) {
-		return *sym;
-	}
-	return {};
+	auto first = valueIndex[value];
+	auto last  = valueIndex[value + 1];
+	return std::span{symbolsByValue}.subspan(first, last - first);
 }
 
 std::string SymbolManager::getFileFilters()
@@ -2,7 +2,6 @@
 #define SYMBOL_MANAGER_HH
 
 #include "function_ref.hh"
-#include "hash_map.hh"
 #include "zstring_view.hh"
 
 #include <cassert>
@@ -110,7 +109,10 @@ private:
 	CommandController& commandController;
 	SymbolObserver* observer = nullptr; // only one for now, could become a vector later
 	std::vector<SymbolFile> files;
-	hash_map<uint16_t, std::vector<const Symbol*>> lookupValueCache; // calculated from 'files'
+	// Calculated from 'files' (on first use): all symbols sorted on value,
+	// and per value the index of its first symbol in that array.
+	std::vector<const Symbol*> symbolsByValue;
+	std::vector<uint32_t> valueIndex; // 0x10000 + 1 entries
 };
 
 
@@ -0,0 +1,108 @@
+#include "Trainer.hh"
+
+#include "MSXCPUInterface.hh"
+#include "MSXMotherBoard.hh"
+#include "VDP.hh"
+
+#include "narrow.hh"
+#include "serialize.hh"
+#include "serialize_stl.hh"
+
+namespace openmsx {
+
+Trainer::Trainer(MSXMotherBoard& motherBoard_)
+	: Schedulable(motherBoard_.getScheduler())
+	, motherBoard(motherBoard_)
+{
+}
+
+void Trainer::set(std::vector<Action> actions_, std::optional<EmuDuration> period_)
+{
+	actions = std::move(actions_);
+	period = period_;
+	removeSyncPoint();
+	if (actions.empty()) return;
+	// Apply immediately, like the first iteration of the Tcl loop did.
+	auto time = getCurrentTime();
+	apply(time);
+	scheduleNext(time);
+}
+
+void Trainer::clear()
+{
+	set({}, std::nullopt);
+}
+
+void Trainer::apply(EmuTime::param time)
+{
+	auto& interface = motherBoard.getCPUInterface();
+	for (const auto& a : actions) {
+		if (a.slotted) {
+			if ((a.condition == Condition::IF_DIFFERENT) &&
+			    (interface.peekSlottedMem(a.address, time) == a.value)) continue;
+			interface.writeSlottedMem(a.address, a.value, time);
+		} else {
+			auto addr = narrow<word>(a.address);
+			if ((a.condition == Condition::IF_DIFFERENT) &&
+			    (interface.peekMem(addr, time) == a.value)) continue;
+			interface.writeMem(addr, a.value, time);
+		}
+	}
+}
+
+void Trainer::scheduleNext(EmuTime::param time)
+{
+	if (period) {
+		setSyncPoint(time + *period);
+		return;
+	}
+	// Every frame: synchronize with the start of the next VDP frame.
+	if (auto* vdp = dynamic_cast<VDP*>(motherBoard.findDevice("VDP"))) {
+		auto frame = VDP::VDPClock::duration(vdp->getTicksPerFrame());
+		auto next = vdp->getFrameStartTime() + frame;
+		while (next <= time) next += frame;
+		setSyncPoint(next);
+	} else {
+		setSyncPoint(time + EmuDuration::hz(60));
+	}
+}
+
+void Trainer::executeUntil(EmuTime::param time)
+{
+	apply(time);
+	scheduleNext(time);
+}
+
+
+static constexpr std::initializer_list<enum_string<Trainer::Condition>> conditionInfo = {
+	{ "always",       Trainer::Condition::ALWAYS       },
+	{ "if_different", Trainer::Condition::IF_DIFFERENT },
+};
+SERIALIZE_ENUM(Trainer::Condition, conditionInfo);
+
+template<typename Archive>
+void Trainer::Action::serialize(Archive& ar, unsigned /*version*/)
+{
+	ar.serialize("address",   address,
+	             "value",     value,
+	             "condition", condition,
+	             "slotted",   slotted);
+}
+INSTANTIATE_SERIALIZE_METHODS(Trainer::Action);
+
+template<typename Archive>
+void Trainer::serialize(Archive& ar, unsigned /*version*/)
+{
+	ar.template serializeBase<Schedulable>(*this);
+	ar.serialize("actions", actions);
+	bool perFrame = !period;
+	EmuDuration interval = period.value_or(EmuDuration());
+	ar.serialize("perFrame", perFrame,
+	             "period",   interval);
+	if constexpr (Archive::IS_LOADER) {
+		period = perFrame ? std::nullopt : std::optional(interval);
+	}
+}
+INSTANTIATE_SERIALIZE_METHODS(Trainer);
+
+} // namespace openmsx
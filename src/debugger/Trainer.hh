@@ -0,0 +1,75 @@
+#ifndef TRAINER_HH
+#define TRAINER_HH
+
+#include "EmuDuration.hh"
+#include "Schedulable.hh"
+
+#include <cstdint>
+#include <optional>
+#include <vector>
+
+namespace openmsx {
+
+class MSXMotherBoard;
+
+/** Native engine behind the 'trainer' script.
+  *
+  * Holds a table of memory pokes that are (re)applied periodically, either
+  * at the start of every VDP frame or at a fixed (emulated) time interval.
+  * The Tcl trainer definitions are translated into this table once, when a
+  * trainer is (de)activated, so applying the cheats doesn't involve the Tcl
+  * interpreter anymore.
+  */
+class Trainer final : public Schedulable
+{
+public:
+	enum class Condition : uint8_t {
+		ALWAYS,       // like 'poke'
+		IF_DIFFERENT, // like 'dpoke': only write when the value differs
+	};
+	struct Action {
+		unsigned address; // in 'slotted memory' format when 'slotted' is set
+		uint8_t value;
+		Condition condition = Condition::ALWAYS;
+		bool slotted = false;
+		[[nodiscard]] bool operator==(const Action&) const = default;
+
+		template<typename Archive>
+		void serialize(Archive& ar, unsigned version);
+	};
+
+	explicit Trainer(MSXMotherBoard& motherBoard);
+
+	/** Replace the current table. When no period is given, the actions
+	  * are applied at the start of each VDP frame. */
+	void set(std::vector<Action> actions, std::optional<EmuDuration> period);
+	void clear();
+
+	[[nodiscard]] bool isActive() const { return !actions.empty(); }
+	[[nodiscard]] const std::vector<Action>& getActions() const { return actions; }
+	[[nodiscard]] const std::optional<EmuDuration>& getPeriod() const { return period; }
+
+	/** Apply all actions once. */
+	void apply(EmuTime::param time);
+
+	/** The table and the pending sync point are part of the machine
+	  * state, so that replays (and reverse) reproduce the same pokes at
+	  * the same moments. */
+	template<typename Archive>
+	void serialize(Archive& ar, unsigned version);
+
+private:
+	void scheduleNext(EmuTime::param time);
+
+	// Schedulable
+	void executeUntil(EmuTime::param time) override;
+
+private:
+	MSXMotherBoard& motherBoard;
+	std::vector<Action> actions;
+	std::optional<EmuDuration> period; // nullopt -> every frame
+};
+
+} // namespace openmsx
+
+#endif
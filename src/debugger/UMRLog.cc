@@ -0,0 +1,34 @@
+#include "UMRLog.hh"
+
+#include "narrow.hh"
+#include "ranges.hh"
+#include "stl.hh"
+#include "view.hh"
+
+#include <algorithm>
+#include <tuple>
+
+namespace openmsx {
+
+unsigned UMRLog::registerRam(std::string_view name)
+{
+	// Ids are never reused, so entries of a removed RAM keep their name.
+	ramNames.emplace_back(name);
+	return narrow<unsigned>(ramNames.size() - 1);
+}
+
+void UMRLog::hit(unsigned ram, unsigned address, uint16_t pc)
+{
+	auto key = (uint64_t(ram) << 32) | address;
+	auto it = entries.try_emplace(key, Entry{ram, address, pc, 0}).first;
+	++it->second.count;
+}
+
+std::vector<UMRLog::Entry> UMRLog::getEntries() const
+{
+	auto result = to_vector<Entry>(view::values(entries));
+	ranges::sort(result, {}, [](const Entry& e) { return std::tuple(e.ram, e.address); });
+	return result;
+}
+
+} // namespace openmsx
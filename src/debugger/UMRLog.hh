@@ -0,0 +1,48 @@
+#ifndef UMRLOG_HH
+#define UMRLOG_HH
+
+#include "hash_map.hh"
+
+#include <cstdint>
+#include <string>
+#include <string_view>
+#include <vector>
+
+namespace openmsx {
+
+/** Deduplicated table of the uninitialized memory reads (UMRs) detected
+  * by CheckedRam.
+  *
+  * Each distinct (RAM, address) pair gets one entry, together with the
+  * CPU program counter of the first hit and the total number of hits. So
+  * recording a hit doesn't involve the Tcl interpreter, and a program that
+  * keeps reading the same uninitialized byte doesn't flood the log.
+  */
+class UMRLog
+{
+public:
+	struct Entry {
+		unsigned ram;     // index in getRamNames()
+		unsigned address;
+		uint16_t pc;      // at the first hit
+		uint64_t count;
+	};
+
+	/** Returns the id to pass to hit(). */
+	[[nodiscard]] unsigned registerRam(std::string_view name);
+
+	void hit(unsigned ram, unsigned address, uint16_t pc);
+	void clear() { entries.clear(); }
+
+	/** All entries, sorted on RAM and address. */
+	[[nodiscard]] std::vector<Entry> getEntries() const;
+	[[nodiscard]] const std::vector<std::string>& getRamNames() const { return ramNames; }
+
+private:
+	hash_map<uint64_t, Entry> entries; // key: ram << 32 | address
+	std::vector<std::string> ramNames;
+};
+
+} // namespace openmsx
+
+#endif
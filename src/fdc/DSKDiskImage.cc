@@ -32,6 +32,13 @@ void DSKDiskImage::writeSectorImpl(size_t sector, const SectorBuffer& buf)
 	file->write(buf.raw);
 }
 
+void DSKDiskImage::writeSectorsImpl(
+	std::span<const SectorBuffer> buffers, size_t startSector)
+{
+	file->seek(startSector * sizeof(SectorBuffer));
+	file->write(buffers);
+}
+
 bool DSKDiskImage::isWriteProtectedImpl() const
 {
 	return file->isReadOnly();
@@ -385,8 +385,9 @@ void DirAsDSK::readSectorImpl(size_t sector, SectorBuffer& buf)
 				return true;
 			}
 		}();
-		if (needSync) {
-			syncWithHost();
+		// Only invalidate when host changes were actually imported,
+		// MSX writes already keep the caches up-to-date.
+		if (needSync && syncWithHost()) {
 			flushCaches(); // e.g. sha1sum
 			// Let the disk drive report the disk has been ejected.
 			// E.g. a turbor machine uses this to flush its
@@ -399,8 +400,16 @@ void DirAsDSK::readSectorImpl(size_t sector, SectorBuffer& buf)
 	buf = sectors[sector];
 }
 
-void DirAsDSK::syncWithHost()
+/** Mirror host changes into the virtual disk.
+  * @return true iff the content of the virtual disk changed.
+  */
+bool DirAsDSK::syncWithHost()
 {
+	// Rescanning the host directory requires a stat() call for every
+	// mapped file. Skip that when we know nothing changed on the host.
+	if (!hostWatcher.checkChanged()) return false;
+	hostChangesImported = false;
+
 	// Check for removed host files. This frees up space in the virtual
 	// disk. Do this first because otherwise later actions may fail (run
 	// out of virtual disk space) for no good reason.
@@ -414,6 +423,8 @@ void DirAsDSK::syncWithHost()
 
 	// Last add new host files (this can only consume virtual disk space).
 	addNewHostFiles({}, firstDirSector);
+
+	return hostChangesImported;
 }
 
 void DirAsDSK::checkDeletedHostFiles()
@@ -478,6 +489,7 @@ void DirAsDSK::deleteMSXFile(DirIndex dirIndex)
 	// At this point we have a regular file or an empty subdirectory.
 	// Delete it by marking the first filename char as 0xE5.
 	msxDir(dirIndex).filename[0] = char(0xE5);
+	hostChangesImported = true;
 
 	// Clear the FAT chain to free up space in the virtual disk.
 	freeFATChain(msxDir(dirIndex).startCluster);
@@ -549,6 +561,7 @@ void DirAsDSK::importHostFile(DirIndex dirIndex, const FileOperations::Stat& fst
 {
 	assert(!(msxDir(dirIndex).attrib & MSXDirEntry::Attrib::DIRECTORY));
 	assert(mapDirs.contains(dirIndex));
+	hostChangesImported = true;
 
 	// Set _msx_ modification time.
 	setMSXTimeStamp(dirIndex, fst);
@@ -705,9 +718,14 @@ void DirAsDSK::addNewHostFiles(const string& hostSubDir, unsigned msxDirSector)
 	assert(!hostSubDir.starts_with('/'));
 	assert(hostSubDir.empty() || hostSubDir.ends_with('/'));
 
+	// Start watching before reading the directory, so that we don't miss
+	// changes that happen while we're scanning.
+	auto fullHostSubDir = strCat(hostDir, hostSubDir);
+	hostWatcher.addDirectory(fullHostSubDir);
+
 	vector<string> hostNames;
 	{
-		ReadDir dir(tmpStrCat(hostDir, hostSubDir));
+		ReadDir dir(fullHostSubDir);
 		while (auto* d = dir.getEntry()) {
 			hostNames.emplace_back(d->d_name);
 		}
@@ -827,6 +845,7 @@ DirAsDSK::DirIndex DirAsDSK::fillMSXDirEntry(
 	const string& hostSubDir, const string& hostName, unsigned msxDirSector)
 {
 	string hostPath = hostSubDir + hostName;
+	hostChangesImported = true;
 	try {
 		// Get empty dir entry (possibly extends subdirectory).
 		DirIndex dirIndex = getFreeDirEntry(msxDirSector);
@@ -907,6 +926,10 @@ void DirAsDSK::writeSectorImpl(size_t sector_, const SectorBuffer& buf)
 		lastAccess = scheduler->getCurrentTime();
 	}
 
+	// Changes made by the MSX can make room for (or otherwise affect)
+	// host files that were not yet mapped. So do a full sync next time.
+	hostWatcher.setChanged();
+
 	if (sector == 0) {
 		// Ignore. We don't allow writing to the boot sector. It would
 		// be very bad if the MSX tried to format this disk using other
@@ -1,6 +1,7 @@
 #ifndef DIRASDSK_HH
 #define DIRASDSK_HH
 
+#include "DirWatcher.hh"
 #include "DiskImageUtils.hh"
 #include "EmuTime.hh"
 #include "FileOperations.hh"
@@ -70,7 +71,7 @@ private:
 	void writeDataSector(unsigned sector, const SectorBuffer& buf);
 	void writeDIREntry(DirIndex dirIndex, DirIndex dirDirIndex,
 	                   const MSXDirEntry& newEntry);
-	void syncWithHost();
+	bool syncWithHost();
 	void checkDeletedHostFiles();
 	void deleteMSXFile(DirIndex dirIndex);
 	void deleteMSXFilesInDir(unsigned msxDirSector);
@@ -130,6 +131,12 @@ private:
 
 	EmuTime lastAccess = EmuTime::zero(); // last time there was a sector read/write
 
+	// Tracks changes in the host directory (and its subdirectories) so
+	// that syncWithHost() can skip the full rescan when nothing changed.
+	DirWatcher hostWatcher;
+	// Set when syncWithHost() changed the virtual disk content.
+	bool hostChangesImported = false;
+
 	// For each directory entry that has a mapped host file/directory we
 	// store the name, last modification time and size of the corresponding
 	// host file/dir.
@@ -66,6 +66,11 @@ protected:
 
 private:
 	virtual void writeSectorImpl(size_t sector, const SectorBuffer& buf) = 0;
+	// Default writeSectorsImpl() implementation delegates to
+	// writeSectorImpl(). Subclasses can override it when they can write
+	// a range of consecutive sectors more efficiently.
+	virtual void writeSectorsImpl(
+		std::span<const SectorBuffer> buffers, size_t startSector);
 	[[nodiscard]] virtual size_t getNbSectorsImpl() const = 0;
 	[[nodiscard]] virtual bool isWriteProtectedImpl() const = 0;
 
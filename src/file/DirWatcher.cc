@@ -0,0 +1,60 @@
+#include "DirWatcher.hh"
+
+#ifdef __linux__
+#include <array>
+#include <sys/inotify.h>
+#include <unistd.h>
+#endif
+
+namespace openmsx {
+
+DirWatcher::DirWatcher()
+{
+#ifdef __linux__
+	fd = inotify_init1(IN_NONBLOCK | IN_CLOEXEC);
+#endif
+}
+
+DirWatcher::~DirWatcher()
+{
+#ifdef __linux__
+	if (fd != -1) close(fd);
+#endif
+}
+
+void DirWatcher::addDirectory([[maybe_unused]] zstring_view directory)
+{
+#ifdef __linux__
+	if (fd == -1) return;
+	static constexpr uint32_t mask =
+		IN_CREATE | IN_DELETE | IN_MODIFY | IN_ATTRIB | IN_CLOSE_WRITE |
+		IN_MOVED_FROM | IN_MOVED_TO | IN_DELETE_SELF | IN_MOVE_SELF;
+	if (inotify_add_watch(fd, directory.c_str(), mask) == -1) {
+		// Can't reliably watch all directories, fall back to always
+		// reporting changes.
+		close(fd);
+		fd = -1;
+	}
+#endif
+}
+
+bool DirWatcher::checkChanged()
+{
+#ifdef __linux__
+	if (fd == -1) return true;
+	// Drain all pending events. We don't care about the details, only
+	// about whether there was at least one event (this includes the
+	// IN_Q_OVERFLOW event).
+	alignas(inotify_event) std::array<char, 4096> buf;
+	while (read(fd, buf.data(), buf.size()) > 0) {
+		changed = true;
+	}
+	bool result = changed;
+	changed = false;
+	return result;
+#else
+	return true;
+#endif
+}
+
+} // namespace openmsx
@@ -0,0 +1,52 @@
+#ifndef DIRWATCHER_HH
+#define DIRWATCHER_HH
+
+#include "zstring_view.hh"
+
+namespace openmsx {
+
+/**
+ * Detect changes in a set of host directories.
+ *
+ * On Linux this uses inotify, so querying for changes doesn't touch the
+ * filesystem at all. On other platforms (or when inotify is not available,
+ * e.g. because the per-user watch limit is reached) this class always
+ * reports that something (possibly) changed, so the caller falls back to
+ * rescanning the directories.
+ *
+ * Watches are not recursive: each (sub)directory must be added explicitly.
+ */
+class DirWatcher final
+{
+public:
+	DirWatcher();
+	DirWatcher(const DirWatcher&) = delete;
+	DirWatcher(DirWatcher&&) = delete;
+	DirWatcher& operator=(const DirWatcher&) = delete;
+	DirWatcher& operator=(DirWatcher&&) = delete;
+	~DirWatcher();
+
+	/** Start watching the given directory for added, removed or modified
+	  * entries. Adding the same directory more than once is allowed.
+	  */
+	void addDirectory(zstring_view directory);
+
+	/** Returns true iff something (possibly) changed in one of the watched
+	  * directories since the previous call (or since construction, so the
+	  * first call always returns true).
+	  */
+	[[nodiscard]] bool checkChanged();
+
+	/** Force the next checkChanged() call to return true. */
+	void setChanged() { changed = true; }
+
+private:
+#ifdef __linux__
+	int fd = -1;
+#endif
+	bool changed = true;
+};
+
+} // namespace openmsx
+
+#endif
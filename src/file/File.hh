@@ -155,7 +155,8 @@ public:
 
 private:
 	friend class LocalFileReference;
-	/** This is an internal method used by LocalFileReference.
+	friend class RomStore;
+	/** This is an internal method used by LocalFileReference and RomStore.
 	 * Returns the path to the (uncompressed) file on the local,
 	 * filesystem. Or an empty string in case there is no such path.
 	 */
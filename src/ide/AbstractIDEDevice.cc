@@ -182,7 +182,7 @@ word AbstractIDEDevice::readData(EmuTime::param /*time*/)
 void AbstractIDEDevice::readNextBlock()
 {
 	bufferLeft = readBlockStart(
-		buffer, std::min<unsigned>(sizeof(buffer), transferCount));
+		buffer, std::min(blockSize, transferCount));
 	assert((bufferLeft & 1) == 0);
 	transferIdx = 0;
 	transferCount -= bufferLeft;
@@ -218,7 +218,7 @@ void AbstractIDEDevice::writeData(word value, EmuTime::param /*time*/)
 void AbstractIDEDevice::writeNextBlock()
 {
 	transferIdx = 0;
-	bufferLeft = std::min<unsigned>(sizeof(buffer), transferCount);
+	bufferLeft = std::min(blockSize, transferCount);
 	transferCount -= bufferLeft;
 }
 
@@ -345,11 +345,13 @@ AlignedBuffer& AbstractIDEDevice::startShortReadTransfer(unsigned count)
 	return buffer;
 }
 
-void AbstractIDEDevice::startLongReadTransfer(unsigned count)
+void AbstractIDEDevice::startLongReadTransfer(unsigned count, unsigned blockSize_)
 {
 	assert((count & 1) == 0);
+	assert((blockSize_ % 512) == 0 && blockSize_ <= sizeof(buffer));
 	startReadTransfer();
 	transferCount = count;
+	blockSize = blockSize_;
 	readNextBlock();
 }
 
@@ -365,11 +367,13 @@ void AbstractIDEDevice::abortReadTransfer(byte error)
 	setTransferRead(false);
 }
 
-void AbstractIDEDevice::startWriteTransfer(unsigned count)
+void AbstractIDEDevice::startWriteTransfer(unsigned count, unsigned blockSize_)
 {
+	assert((blockSize_ % 512) == 0 && blockSize_ <= sizeof(buffer));
 	statusReg |= DRQ;
 	setTransferWrite(true);
 	transferCount = count;
+	blockSize = blockSize_;
 	writeNextBlock();
 }
 
@@ -435,11 +439,19 @@ void AbstractIDEDevice::createIdentifyBlock(AlignedBuffer& buf)
 }
 
 
+// version 1: initial version
+// version 2: buffer of MAX_BLOCK_SECTORS sectors (was 1), added blockSize
 template<typename Archive>
-void AbstractIDEDevice::serialize(Archive& ar, unsigned /*version*/)
+void AbstractIDEDevice::serialize(Archive& ar, unsigned version)
 {
 	// no need to serialize IDEDevice base class
-	ar.serialize_blob("buffer", buffer);
+	if (ar.versionAtLeast(version, 2)) {
+		ar.serialize_blob("buffer", buffer);
+		ar.serialize("blockSize", blockSize);
+	} else {
+		ar.serialize_blob("buffer", std::span{buffer.data(), 512});
+		blockSize = 512;
+	}
 	ar.serialize("transferIdx",     transferIdx,
 	             "bufferLeft",      bufferLeft,
 	             "transferCount",   transferCount,
@@ -36,6 +36,9 @@ protected:
 	static constexpr byte IDNF = 0x10;
 	static constexpr byte ABORT = 0x04;
 
+	// Max number of sectors per block of a READ/WRITE MULTIPLE transfer.
+	static constexpr unsigned MAX_BLOCK_SECTORS = 16;
+
 	explicit AbstractIDEDevice(MSXMotherBoard& motherBoard);
 	~AbstractIDEDevice() override = default;
 
@@ -126,8 +129,10 @@ protected:
 	  * The first block will be read immediately, so make sure you initialise
 	  * all variables needed by readBlockStart() before calling this method.
 	  * @param count Total number of bytes to transfer.
+	  * @param blockSize Number of bytes per block (DRQ data block), a
+	  *   multiple of 512 and at most MAX_BLOCK_SECTORS * 512.
 	  */
-	void startLongReadTransfer(unsigned count);
+	void startLongReadTransfer(unsigned count, unsigned blockSize = 512);
 
 	/** Indicates the start of a read data transfer where all data fits
 	  * into the buffer at once.
@@ -144,8 +149,9 @@ protected:
 
 	/** Indicates the start of a write data transfer.
 	  * @param count Total number of bytes to transfer.
+	  * @param blockSize Number of bytes per block, see startLongReadTransfer().
 	  */
-	void startWriteTransfer(unsigned count);
+	void startWriteTransfer(unsigned count, unsigned blockSize = 512);
 
 	/** Aborts the write transfer in progress.
 	  */
@@ -203,11 +209,14 @@ private:
 	MSXMotherBoard& motherBoard;
 
 	/** Data buffer shared by all transfers.
-	  * The size must be a multiple of 512.
-	  * Right now I don't see any reason to make it larger than the minimum
-	  * size of 1 * 512.
+	  * The size must be a multiple of 512. It holds the largest block of
+	  * a READ/WRITE MULTIPLE transfer.
+	  */
+	AlignedByteArray<MAX_BLOCK_SECTORS * 512> buffer;
+
+	/** Number of bytes per block of the current transfer.
 	  */
-	AlignedByteArray<512> buffer;
+	unsigned blockSize = 512;
 
 	/** Index of current read/write position in the buffer.
 	  */
@@ -236,6 +245,7 @@ private:
 	bool transferWrite = false;
 };
 
+SERIALIZE_CLASS_VERSION(AbstractIDEDevice, 2);
 REGISTER_BASE_NAME_HELPER(AbstractIDEDevice, "IDEDevice");
 
 } // namespace openmsx
@@ -117,9 +117,16 @@ void HD::readSectorsImpl(
 
 void HD::writeSectorImpl(size_t sector, const SectorBuffer& buf)
 {
-	file.seek(sector * sizeof(buf));
-	file.write(buf.raw);
-	tigerTree->notifyChange(sector * sizeof(buf), sizeof(buf),
+	writeSectorsImpl(std::span{&buf, 1}, sector);
+}
+
+void HD::writeSectorsImpl(
+	std::span<const SectorBuffer> buffers, size_t startSector)
+{
+	auto offset = startSector * sizeof(SectorBuffer);
+	file.seek(offset);
+	file.write(buffers);
+	tigerTree->notifyChange(offset, buffers.size_bytes(),
 	                        file.getModificationDate());
 }
 
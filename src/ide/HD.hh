@@ -48,6 +48,8 @@ private:
 	void readSectorsImpl(
 		std::span<SectorBuffer> buffers, size_t startSector) override;
 	void writeSectorImpl(size_t sector, const SectorBuffer& buf) override;
+	void writeSectorsImpl(
+		std::span<const SectorBuffer> buffers, size_t startSector) override;
 	[[nodiscard]] size_t getNbSectorsImpl() const override;
 	[[nodiscard]] bool isWriteProtectedImpl() const override;
 	[[nodiscard]] Sha1Sum getSha1SumImpl(FilePool& filePool) override;
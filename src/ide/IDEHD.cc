@@ -7,8 +7,9 @@
 #include "endian.hh"
 #include "narrow.hh"
 #include "serialize.hh"
+#include "one_of.hh"
 #include "strCat.hh"
-#include "xrange.hh"
+#include <bit>
 #include <cassert>
 
 namespace openmsx {
@@ -37,6 +38,12 @@ std::string_view IDEHD::getDeviceName()
 	return "OPENMSX HARD DISK";
 }
 
+void IDEHD::reset(EmuTime::param time)
+{
+	multipleCount = 0;
+	AbstractIDEDevice::reset(time);
+}
+
 void IDEHD::fillIdentifyBlock(AlignedBuffer& buf)
 {
 	auto totalSectors = getNbSectors();
@@ -47,13 +54,17 @@ void IDEHD::fillIdentifyBlock(AlignedBuffer& buf)
 	Endian::writeL16(&buf[3 * 2], heads);
 	Endian::writeL16(&buf[6 * 2], sectors);
 
-	buf[47 * 2 + 0] = 16; // max sector transfer per interrupt
+	buf[47 * 2 + 0] = MAX_BLOCK_SECTORS; // max sector transfer per interrupt
 	buf[47 * 2 + 1] = 0x80; // specced value
 
 	// .... 1...: IORDY supported (hardware signal used by PIO modes >3)
 	// .... ..1.: LBA supported
 	buf[49 * 2 + 1] = 0x0A;
 
+	// current multiple sector setting (bit 8: setting is valid)
+	buf[59 * 2 + 0] = narrow<byte>(multipleCount);
+	buf[59 * 2 + 1] = multipleCount ? 0x01 : 0x00;
+
 	// TODO check for overflow
 	Endian::writeL32(&buf[60 * 2], unsigned(totalSectors));
 }
@@ -61,12 +72,14 @@ void IDEHD::fillIdentifyBlock(AlignedBuffer& buf)
 unsigned IDEHD::readBlockStart(AlignedBuffer& buf, unsigned count)
 {
 	try {
+		// One sector for READ SECTOR(S), a whole block of sectors (one
+		// host read) for READ MULTIPLE.
 		assert(count >= 512);
-		(void)count; // avoid warning
-		readSector(transferSectorNumber,
-		           *aligned_cast<SectorBuffer*>(buf));
-		++transferSectorNumber;
-		return 512;
+		size_t num = count / 512;
+		readSectors(std::span{aligned_cast<SectorBuffer*>(buf), num},
+		            transferSectorNumber);
+		transferSectorNumber += narrow<unsigned>(num);
+		return narrow<unsigned>(num * 512);
 	} catch (MSXException&) {
 		abortReadTransfer(UNC);
 		return 0;
@@ -78,10 +91,9 @@ void IDEHD::writeBlockComplete(AlignedBuffer& buf, unsigned count)
 	try {
 		assert((count % 512) == 0);
 		size_t num = count / 512;
-		for (auto i : xrange(num)) {
-			writeSector(transferSectorNumber++,
-			            *aligned_cast<SectorBuffer*>(buf + 512 * i));
-		}
+		writeSectors(std::span{aligned_cast<const SectorBuffer*>(buf), num},
+		             transferSectorNumber);
+		transferSectorNumber += narrow<unsigned>(num);
 	} catch (MSXException&) {
 		abortWriteTransfer(UNC);
 	}
@@ -99,7 +111,15 @@ void IDEHD::executeCommand(byte cmd)
 	case 0x20: // Read Sector
 	case 0x21: // Read Sector without Retry
 	case 0x30: // Write Sector
-	case 0x31: { // Write Sector without Retry
+	case 0x31: // Write Sector without Retry
+	case 0xC4: // Read Multiple
+	case 0xC5: { // Write Multiple
+		bool multiple = cmd >= 0xC4;
+		if (multiple && (multipleCount == 0)) {
+			// Multiple mode is not enabled.
+			setError(ABORT);
+			break;
+		}
 		unsigned sectorNumber = getSectorNumber();
 		unsigned numSectors = getNumSectors();
 		if ((sectorNumber + numSectors) > getNbSectors()) {
@@ -109,10 +129,23 @@ void IDEHD::executeCommand(byte cmd)
 			break;
 		}
 		transferSectorNumber = sectorNumber;
-		if (cmd < 0x30) {
-			startLongReadTransfer(numSectors * 512);
+		unsigned blockSize = (multiple ? multipleCount : 1) * 512;
+		if (cmd == one_of(0x20, 0x21, 0xC4)) {
+			startLongReadTransfer(numSectors * 512, blockSize);
 		} else {
-			startWriteTransfer(numSectors * 512);
+			startWriteTransfer(numSectors * 512, blockSize);
+		}
+		break;
+	}
+
+	case 0xC6: { // Set Multiple Mode
+		unsigned count = getNumSectors(); // 256 means 0: disable
+		if (count == 256) {
+			multipleCount = 0;
+		} else if ((count <= MAX_BLOCK_SECTORS) && std::has_single_bit(count)) {
+			multipleCount = count;
+		} else {
+			setError(ABORT);
 		}
 		break;
 	}
@@ -130,13 +163,18 @@ void IDEHD::executeCommand(byte cmd)
 }
 
 
+// version 1: initial version
+// version 2: added multipleCount
 template<typename Archive>
-void IDEHD::serialize(Archive& ar, unsigned /*version*/)
+void IDEHD::serialize(Archive& ar, unsigned version)
 {
 	// don't serialize SectorAccessibleDisk, DiskContainer base classes
 	ar.template serializeBase<HD>(*this);
 	ar.template serializeBase<AbstractIDEDevice>(*this);
 	ar.serialize("transferSectorNumber", transferSectorNumber);
+	if (ar.versionAtLeast(version, 2)) {
+		ar.serialize("multipleCount", multipleCount);
+	}
 }
 INSTANTIATE_SERIALIZE_METHODS(IDEHD);
 REGISTER_POLYMORPHIC_INITIALIZER(IDEDevice, IDEHD, "IDEHD");
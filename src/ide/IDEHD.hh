@@ -19,6 +19,8 @@ public:
 	IDEHD& operator=(IDEHD&&) = delete;
 	~IDEHD() override;
 
+	void reset(EmuTime::param time) override;
+
 	template<typename Archive>
 	void serialize(Archive& ar, unsigned version);
 
@@ -34,7 +36,9 @@ private:
 private:
 	DiskManipulator& diskManipulator;
 	unsigned transferSectorNumber = 0; // avoid UMR in serialize()
+	unsigned multipleCount = 0; // sectors per READ/WRITE MULTIPLE block, 0 = disabled
 };
+SERIALIZE_CLASS_VERSION(IDEHD, 2);
 
 } // namespace openmsx
 
@@ -332,6 +332,11 @@ void DebuggableEditor::drawContents(const Sizes& s, Debuggable& debuggable, unsi
 		auto addr = unsigned(line) * columns;
 		ImGui::StrCat(formatAddr(s, addr), ':');
 
+		// fetch the content of the whole line at once
+		const auto lineStart = addr;
+		std::array<uint8_t, MAX_COLUMNS> lineData;
+		debuggable.readBlock(lineStart, std::span{lineData.data(), std::min(unsigned(columns), memSize - lineStart)});
+
 		auto previewDataTypeSize = DataTypeGetSize(previewDataType);
 		auto inside = [](unsigned a, unsigned start, unsigned size) {
 			return (start <= a) && (a < (start + size));
@@ -390,7 +395,7 @@ void DebuggableEditor::drawContents(const Sizes& s, Debuggable& debuggable, unsi
 					},
 					ImGuiInputTextFlags_CharsHexadecimal);
 			} else {
-				uint8_t b = debuggable.read(addr);
+				uint8_t b = lineData[addr - lineStart];
 				im::StyleColor(b == 0 && greyOutZeroes, ImGuiCol_Text, getColor(imColor::TEXT_DISABLED), [&]{
 					ImGui::StrCat(formatData(b), ' ');
 				});
@@ -440,7 +445,7 @@ void DebuggableEditor::drawContents(const Sizes& s, Debuggable& debuggable, unsi
 							return b;
 						});
 				} else {
-					uint8_t c = debuggable.read(addr);
+					uint8_t c = lineData[addr - lineStart];
 					char display = formatAsciiData(c);
 					im::StyleColor(display != char(c), ImGuiCol_Text, getColor(imColor::TEXT_DISABLED), [&]{
 						ImGui::TextUnformatted(&display, &display + 1);
@@ -776,9 +781,8 @@ void DebuggableEditor::drawPreviewLine(const Sizes& s, Debuggable& debuggable, u
 
 	std::array<uint8_t, 8> dataBuf = {};
 	auto elemSize = DataTypeGetSize(previewDataType);
-	for (auto i : xrange(elemSize)) {
-		auto addr = currentAddr + i;
-		dataBuf[i] = (addr < memSize) ? debuggable.read(addr) : 0;
+	if (currentAddr < memSize) {
+		debuggable.readBlock(currentAddr, subspan(dataBuf, 0, std::min(unsigned(elemSize), memSize - currentAddr)));
 	}
 
 	static constexpr bool nativeIsLittle = std::endian::native == std::endian::little;
@@ -55,7 +55,8 @@ static void saveItems(zstring_view label, const std::vector<ImGuiBreakPoints::Gu
 			item.addrStr,
 			item.endAddrStr,
 			item.cond,
-			item.cmd);
+			item.cmd,
+			item.logOnly);
 		buf.appendf("%s=%s\n", label.c_str(), list.getString().c_str());
 	}
 }
@@ -80,7 +81,8 @@ void ImGuiBreakPoints::loadItem(zstring_view value)
 
 	try {
 		TclObject list(value);
-		if (list.getListLength(interp) != 8) return; // ignore
+		auto len = list.getListLength(interp);
+		if (len != one_of(8u, 9u)) return; // ignore (9th element was added later)
 		GuiItem item {
 			.id = --idCounter,
 			.wantEnable = list.getListIndex(interp, 0).getBoolean(interp),
@@ -91,6 +93,7 @@ void ImGuiBreakPoints::loadItem(zstring_view value)
 			.endAddrStr = list.getListIndex(interp, 5),
 			.cond       = list.getListIndex(interp, 6),
 			.cmd        = list.getListIndex(interp, 7),
+			.logOnly    = (len == 9) && list.getListIndex(interp, 8).getBoolean(interp),
 		};
 		if (item.wpType < 0 || item.wpType > 3) return;
 
@@ -472,6 +475,7 @@ void ImGuiBreakPoints::syncFromOpenMsx(std::vector<GuiItem>& items, MSXCPUInterf
 			// item exists on the openMSX side, make sure it's in sync
 			if constexpr (isWatchPoint) {
 				it->wpType = to_underlying(item->getType());
+				it->logOnly = item->isLogOnly();
 			}
 			if constexpr (hasAddress) {
 				assert(it->addr);
@@ -499,8 +503,10 @@ void ImGuiBreakPoints::syncFromOpenMsx(std::vector<GuiItem>& items, MSXCPUInterf
 			std::optional<uint16_t> endAddr;
 			TclObject addrStr;
 			TclObject endAddrStr;
+			bool logOnly = false;
 			if constexpr (isWatchPoint) {
 				wpType = item->getType();
+				logOnly = item->isLogOnly();
 			}
 			if constexpr (hasAddress) {
 				addr = getAddress(item);
@@ -514,7 +520,7 @@ void ImGuiBreakPoints::syncFromOpenMsx(std::vector<GuiItem>& items, MSXCPUInterf
 				true,
 				to_underlying(wpType),
 				addr, endAddr, std::move(addrStr), std::move(endAddrStr),
-				getConditionObj(item), getCommandObj(item)});
+				getConditionObj(item), getCommandObj(item), logOnly});
 			selectedRow = -1;
 		}
 	}
@@ -599,7 +605,7 @@ static void create(WatchPoint*, MSXCPUInterface&, Debugger& debugger, ImGuiBreak
 		item.cmd, item.cond,
 		static_cast<WatchPoint::Type>(item.wpType),
 		*item.addr, (item.endAddr ? *item.endAddr : *item.addr),
-		false);
+		false, item.logOnly);
 }
 static void create(DebugCondition*, MSXCPUInterface& cpuInterface, Debugger&, ImGuiBreakPoints::GuiItem& item)
 {
@@ -748,15 +754,22 @@ void ImGuiBreakPoints::drawRow(MSXCPUInterface& cpuInterface, Debugger& debugger
 		});
 	}
 	if (ImGui::TableNextColumn()) { // action
-		setRedBg(validCmd);
-		im::Font(manager.fontMono, [&]{
-			ImGui::SetNextItemWidth(-FLT_MIN);
-			if (ImGui::InputText("##cmd", &cmd)) {
-				item.cmd = cmd;
-				needSync = true;
-			}
-			if (ImGui::IsItemActive()) selectedRow = row;
-		});
+		if (item.logOnly) {
+			// the command is not executed, accesses are only logged
+			ImGui::TextDisabled("log only");
+			simpleToolTip("Accesses are recorded instead of executing a command, "
+			              "retrieve them with 'debug watchpoint_log'.");
+		} else {
+			setRedBg(validCmd);
+			im::Font(manager.fontMono, [&]{
+				ImGui::SetNextItemWidth(-FLT_MIN);
+				if (ImGui::InputText("##cmd", &cmd)) {
+					item.cmd = cmd;
+					needSync = true;
+				}
+				if (ImGui::IsItemActive()) selectedRow = row;
+			});
+		}
 	}
 	if (needSync) {
 		syncToOpenMsx<Item>(cpuInterface, debugger, interp, item);
@@ -46,6 +46,7 @@ public:
 		TclObject endAddrStr;
 		TclObject cond;
 		TclObject cmd;
+		bool logOnly = false; // only used for WatchPoint, see 'set_watchpoint -log'
 	};
 
 public:
@@ -8,6 +8,8 @@
 #include "stl.hh"
 #include "view.hh"
 
+#include <optional>
+
 namespace openmsx {
 
 using namespace std::literals;
@@ -17,7 +19,10 @@ void ImGuiCheatFinder::paint(MSXMotherBoard* /*motherBoard*/)
 	if (!show) return;
 
 	bool start = false;
-	std::string searchExpr;
+	std::optional<TclObject> searchCmd;
+	auto filter = [&](auto... args) {
+		searchCmd = makeTclList("debug", "cheat_search", "filter", args...);
+	};
 
 	ImGui::SetNextWindowSize(gl::vec2{35, 0} * ImGui::GetFontSize(), ImGuiCond_FirstUseEver);
 	im::Window("Cheat Finder", &show, [&]{
@@ -37,22 +42,22 @@ void ImGuiCheatFinder::paint(MSXMotherBoard* /*motherBoard*/)
 				ImGui::TextUnformatted("Compare"sv);
 				im::Indent([&]{
 					auto bSize = ImVec2{tSize, 0.0f};
-					if (ImGui::Button("<",  bSize)) searchExpr = "$new < $old";
+					if (ImGui::Button("<",  bSize)) filter("<");
 					simpleToolTip("Search for memory locations with strictly decreased value");
 					ImGui::SameLine(0.0f, bSpacing);
-					if (ImGui::Button("<=", bSize)) searchExpr = "$new <= $old";
+					if (ImGui::Button("<=", bSize)) filter("<=");
 					simpleToolTip("Search for memory locations with decreased value");
 					ImGui::SameLine(0.0f, bSpacing);
-					if (ImGui::Button("!=", bSize)) searchExpr = "$new != $old";
+					if (ImGui::Button("!=", bSize)) filter("!=");
 					simpleToolTip("Search for memory locations with changed value");
 					ImGui::SameLine(0.0f, bSpacing);
-					if (ImGui::Button("==", bSize)) searchExpr = "$new == $old";
+					if (ImGui::Button("==", bSize)) filter("==");
 					simpleToolTip("Search for memory locations with unchanged value");
 					ImGui::SameLine(0.0f, bSpacing);
-					if (ImGui::Button(">=", bSize)) searchExpr = "$new >= $old";
+					if (ImGui::Button(">=", bSize)) filter(">=");
 					simpleToolTip("Search for memory locations with increased value");
 					ImGui::SameLine(0.0f, bSpacing);
-					if (ImGui::Button(">",  bSize)) searchExpr = "$new > $old";
+					if (ImGui::Button(">",  bSize)) filter(">");
 					simpleToolTip("Search for memory locations with strictly increased value");
 				});
 				ImGui::TextUnformatted("Specific value"sv);
@@ -61,7 +66,7 @@ void ImGuiCheatFinder::paint(MSXMotherBoard* /*motherBoard*/)
 					ImGui::InputScalar("##value", ImGuiDataType_U8, &searchValue);
 					ImGui::SameLine();
 					if (ImGui::Button("Go")) {
-						searchExpr = strCat("$new == ", searchValue);
+						filter("==", int(searchValue));
 					}
 					simpleToolTip("Search for memory locations with a specific value");
 				});
@@ -109,11 +114,11 @@ void ImGuiCheatFinder::paint(MSXMotherBoard* /*motherBoard*/)
 	});
 
 	if (start) {
-		manager.execute(TclObject("cheat_finder::start"));
-		searchExpr = "1"; // could be optimized, but good enough
+		searchCmd = makeTclList("debug", "cheat_search", "start", "memory");
 	}
-	if (!searchExpr.empty()) {
-		auto result = manager.execute(makeTclList("cheat_finder::search", searchExpr)).value_or(TclObject{});
+	if (searchCmd) {
+		manager.execute(*searchCmd);
+		auto result = manager.execute(makeTclList("debug", "cheat_search", "results")).value_or(TclObject{});
 		searchResults = to_vector(view::transform(xrange(result.size()), [&](size_t i) {
 			auto line = result.getListIndexUnchecked(narrow<unsigned>(i));
 			auto addr     = line.getListIndexUnchecked(0).getOptionalInt().value_or(0);
@@ -4,6 +4,7 @@
 #include "ImGuiBreakPoints.hh"
 #include "ImGuiCharacter.hh"
 #include "ImGuiCpp.hh"
+#include "ImGuiHeatMap.hh"
 #include "ImGuiManager.hh"
 #include "ImGuiPalette.hh"
 #include "ImGuiSpriteViewer.hh"
@@ -172,6 +173,7 @@ void ImGuiDebugger::showMenu(MSXMotherBoard* motherBoard)
 		ImGui::MenuItem("Breakpoints", nullptr, &manager.breakPoints->show);
 		ImGui::MenuItem("Symbol manager", nullptr, &manager.symbols->show);
 		ImGui::MenuItem("Watch expression", nullptr, &manager.watchExpr->show);
+		ImGui::MenuItem("Memory heat map", nullptr, &manager.heatMap->show);
 		ImGui::Separator();
 		ImGui::MenuItem("VDP bitmap viewer", nullptr, &manager.bitmap->showBitmapViewer);
 		ImGui::MenuItem("VDP tile viewer", nullptr, &manager.character->show);
@@ -393,6 +395,46 @@ static BpLine examineBpLine(uint16_t addr, std::span<const ImGuiBreakPoints::Gui
 	return result;
 }
 
+unsigned ImGuiDebugger::disassemble(
+	const MSXCPUInterface& cpuInterface, uint16_t addr,
+	std::array<uint8_t, 4>& opcodes, std::string& mnemonic,
+	std::optional<uint16_t>& mnemonicAddr,
+	std::span<const Symbol* const>& mnemonicLabels,
+	EmuTime::param time)
+{
+	for (auto i : xrange(4)) {
+		opcodes[i] = cpuInterface.peekMem(narrow_cast<uint16_t>(addr + i), time);
+	}
+	auto& entry = disasmCache[addr % disasmCache.size()];
+	if ((entry.len == 0) || (entry.addr != addr) || (entry.opcodes != opcodes)) {
+		entry.mnemonic.clear();
+		entry.mnemonicAddr.reset();
+		std::array<uint8_t, 4> buf;
+		entry.len = narrow<uint8_t>(dasm(cpuInterface, addr, buf, entry.mnemonic, time,
+			[&](std::string& output, uint16_t a) {
+				entry.mnemonicAddr = a;
+				entry.addrPos = narrow<uint8_t>(output.size());
+				appendAddrAsHex(output, a);
+				entry.addrLen = narrow<uint8_t>(output.size() - entry.addrPos);
+			}));
+		entry.addr = addr;
+		entry.opcodes = opcodes;
+	}
+
+	mnemonicAddr = entry.mnemonicAddr;
+	mnemonicLabels = mnemonicAddr ? symbolManager.lookupValue(*mnemonicAddr)
+	                              : std::span<const Symbol* const>{};
+	if (mnemonicLabels.empty()) {
+		mnemonic = entry.mnemonic;
+	} else {
+		std::string_view str = entry.mnemonic;
+		mnemonic = strCat(str.substr(0, entry.addrPos),
+		                  mnemonicLabels[cycleLabelsCounter % mnemonicLabels.size()]->name,
+		                  str.substr(entry.addrPos + entry.addrLen));
+	}
+	return entry.len;
+}
+
 void ImGuiDebugger::drawDisassembly(CPURegs& regs, MSXCPUInterface& cpuInterface, Debugger& debugger, EmuTime::param time)
 {
 	if (!showDisassembly) return;
@@ -516,19 +558,10 @@ void ImGuiDebugger::drawDisassembly(CPURegs& regs, MSXCPUInterface& cpuInterface
 							}
 						}
 
-						mnemonic.clear();
 						std::optional<uint16_t> mnemonicAddr;
 						std::span<const Symbol* const> mnemonicLabels;
-						auto len = dasm(cpuInterface, addr16, opcodes, mnemonic, time,
-							[&](std::string& output, uint16_t a) {
-								mnemonicAddr = a;
-								mnemonicLabels = symbolManager.lookupValue(a);
-								if (!mnemonicLabels.empty()) {
-									strAppend(output, mnemonicLabels[cycleLabelsCounter % mnemonicLabels.size()]->name);
-								} else {
-									appendAddrAsHex(output, a);
-								}
-							});
+						auto len = disassemble(cpuInterface, addr16, opcodes, mnemonic,
+						                       mnemonicAddr, mnemonicLabels, time);
 						assert(len >= 1);
 						if ((addr < pc) && (pc < (addr + len))) {
 							// pc is strictly inside current instruction,
@@ -6,8 +6,11 @@
 
 #include "EmuTime.hh"
 
+#include <array>
+#include <cstdint>
 #include <memory>
 #include <optional>
+#include <span>
 #include <string>
 
 namespace openmsx {
@@ -17,6 +20,7 @@ class Debuggable;
 class Debugger;
 class MSXCPUInterface;
 class SymbolManager;
+struct Symbol;
 
 class ImGuiDebugger final : public ImGuiPart
 {
@@ -43,6 +47,12 @@ private:
 	void drawRegisters(CPURegs& regs);
 	void drawFlags(CPURegs& regs);
 
+	unsigned disassemble(const MSXCPUInterface& cpuInterface, uint16_t addr,
+	                     std::array<uint8_t, 4>& opcodes, std::string& mnemonic,
+	                     std::optional<uint16_t>& mnemonicAddr,
+	                     std::span<const Symbol* const>& mnemonicLabels,
+	                     EmuTime::param time);
+
 	void checkShortcuts(MSXCPUInterface& cpuInterface);
 	void actionBreakContinue(MSXCPUInterface& cpuInterface);
 	void actionStepIn(MSXCPUInterface& cpuInterface);
@@ -56,6 +66,21 @@ private:
 
 	std::vector<std::unique_ptr<DebuggableEditor>> hexEditors; // sorted on 'getDebuggableName()'
 
+	// Recently disassembled instructions. An entry is only reused when the
+	// instruction bytes in memory are still the same, so this also works
+	// after writes or after switching slots/segments. The address operand
+	// is stored as hex and replaced by a label (if any) on each use.
+	struct DisasmEntry {
+		std::string mnemonic;
+		std::optional<uint16_t> mnemonicAddr;
+		std::array<uint8_t, 4> opcodes = {};
+		uint16_t addr = 0;
+		uint8_t len = 0; // 0 -> entry not (yet) valid
+		uint8_t addrPos = 0; // position and length of the address in 'mnemonic'
+		uint8_t addrLen = 0;
+	};
+	std::array<DisasmEntry, 256> disasmCache; // indexed on the lower address bits
+
 	std::string gotoAddr;
 	std::string runToAddr;
 	std::optional<unsigned> gotoTarget;
@@ -0,0 +1,122 @@
+#include "ImGuiHeatMap.hh"
+
+#include "ImGuiCpp.hh"
+#include "ImGuiManager.hh"
+#include "ImGuiUtils.hh"
+
+#include "HeatMap.hh"
+#include "MSXCPU.hh"
+#include "MSXMotherBoard.hh"
+
+#include "strCat.hh"
+#include "xrange.hh"
+
+#include <imgui.h>
+
+#include <algorithm>
+#include <array>
+#include <cmath>
+
+namespace openmsx {
+
+void ImGuiHeatMap::save(ImGuiTextBuffer& buf)
+{
+	savePersistent(buf, *this, persistentElements);
+}
+
+void ImGuiHeatMap::loadLine(std::string_view name, zstring_view value)
+{
+	loadOnePersistent(name, value, *this, persistentElements);
+}
+
+// Black (never accessed) -> red -> yellow -> white (most accessed).
+static uint32_t heatColor(float t)
+{
+	auto c = [](float x) { return std::clamp(x, 0.0f, 1.0f); };
+	return ImColor(c(3.0f * t), c(3.0f * t - 1.0f), c(3.0f * t - 2.0f));
+}
+
+void ImGuiHeatMap::paint(MSXMotherBoard* motherBoard)
+{
+	if (!show || !motherBoard) return;
+
+	ImGui::SetNextWindowSize({560, 660}, ImGuiCond_FirstUseEver);
+	im::Window("Memory heat map", &show, [&]{
+		auto& heatMap = motherBoard->getCPU().getHeatMap();
+
+		ImGui::TextUnformatted("Count:");
+		for (auto t : xrange(HeatMap::NUM_TYPES)) {
+			ImGui::SameLine();
+			bool enabled = heatMap.isEnabled(HeatMap::Type(t));
+			if (ImGui::Checkbox(HeatMap::typeNames[t].data(), &enabled)) {
+				heatMap.setEnabled(HeatMap::Type(t), enabled);
+			}
+		}
+		simpleToolTip("Counting 'read' or 'write' disables the CPU memory cache, so every "
+		              "memory access takes the slow path: this slows down emulation a lot. "
+		              "Counting 'exec' makes the CPU run one instruction at a time, also "
+		              "a noticeable slowdown. 'in' and 'out' are cheap, and disabled types "
+		              "cost nothing.");
+
+		ImGui::SetNextItemWidth(ImGui::GetFontSize() * 5.0f);
+		ImGui::Combo("Show", &type, "read\000write\000exec\000in\000out\000");
+		ImGui::SameLine();
+		ImGui::SetNextItemWidth(ImGui::GetFontSize() * 3.0f);
+		ImGui::Combo("Zoom", &zoom, "1x\0002x\0003x\0004x\000");
+		ImGui::SameLine();
+		if (ImGui::Button("Clear")) {
+			heatMap.clear(HeatMap::Type(type));
+		}
+
+		auto counts = heatMap.getCounts(HeatMap::Type(type));
+		// memory: one row per 256 bytes, IO: one row per 16 ports
+		int dim = (type < int(HeatMap::NUM_MEM_TYPES)) ? 256 : 16;
+		auto generation = heatMap.getGeneration();
+		auto now = ImGui::GetTime();
+		bool typeChanged = type != texType;
+		if (!tex || typeChanged ||
+		    ((generation != texGeneration) && (now - texTime) >= UPDATE_INTERVAL)) {
+			maxCount = counts.empty() ? 0 : std::ranges::max(counts);
+
+			// Logarithmic scale, otherwise a few tight loops make the rest invisible.
+			std::array<uint32_t, 256 * 256> pixels;
+			auto scale = maxCount ? 1.0f / std::log1p(float(maxCount)) : 0.0f;
+			for (auto i : xrange(dim * dim)) {
+				auto c = counts.empty() ? 0 : counts[i];
+				pixels[i] = heatColor(std::log1p(float(c)) * scale);
+			}
+			if (!tex) {
+				tex.emplace(false, false); // no interpolation, no wrapping
+			}
+			tex->bind();
+			glTexImage2D(GL_TEXTURE_2D, 0, GL_RGBA, dim, dim, 0,
+			             GL_RGBA, GL_UNSIGNED_BYTE, pixels.data());
+			texGeneration = generation;
+			texType = type;
+			texTime = now;
+		}
+		ImGui::SameLine();
+		ImGui::StrCat("max: ", maxCount);
+
+		auto pixelSize = float((zoom + 1) * (dim == 256 ? 1 : 16));
+		gl::vec2 size(float(dim) * pixelSize);
+		gl::vec2 scrnPos = ImGui::GetCursorScreenPos();
+		ImGui::Image(tex->getImGui(), size);
+		if (ImGui::IsItemHovered()) {
+			auto [x, y] = trunc((gl::vec2(ImGui::GetIO().MousePos) - scrnPos) / pixelSize);
+			if ((0 <= x) && (x < dim) && (0 <= y) && (y < dim)) {
+				auto index = unsigned(y * dim + x);
+				im::Tooltip([&]{
+					auto count = counts.empty() ? 0 : counts[index];
+					if (dim == 256) {
+						ImGui::StrCat("address: 0x", hex_string<4>(index), "\ncount: ", count);
+					} else {
+						ImGui::StrCat("port: 0x", hex_string<2>(index), "\ncount: ", count);
+					}
+				});
+			}
+		}
+	});
+}
+
+} // namespace openmsx
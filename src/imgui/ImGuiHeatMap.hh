@@ -0,0 +1,47 @@
+#ifndef IMGUI_HEAT_MAP_HH
+#define IMGUI_HEAT_MAP_HH
+
+#include "ImGuiPart.hh"
+
+#include "GLUtil.hh"
+
+#include <optional>
+
+namespace openmsx {
+
+class ImGuiHeatMap final : public ImGuiPart
+{
+public:
+	using ImGuiPart::ImGuiPart;
+
+	[[nodiscard]] zstring_view iniName() const override { return "heat map"; }
+	void save(ImGuiTextBuffer& buf) override;
+	void loadLine(std::string_view name, zstring_view value) override;
+	void paint(MSXMotherBoard* motherBoard) override;
+
+public:
+	bool show = false;
+
+private:
+	int type = 0; // HeatMap::Type
+	int zoom = 1; // 0->1x, 1->2x, ..., 3->4x
+
+	std::optional<gl::Texture> tex;
+	// The texture only gets re-rendered when the counters (or the shown
+	// type) changed, and while emulation runs at most every 'UPDATE_INTERVAL'.
+	static constexpr double UPDATE_INTERVAL = 0.1; // seconds
+	uint64_t texGeneration = 0;
+	int texType = -1;
+	double texTime = 0.0;
+	uint64_t maxCount = 0;
+
+	static constexpr auto persistentElements = std::tuple{
+		PersistentElement   {"show", &ImGuiHeatMap::show},
+		PersistentElementMax{"type", &ImGuiHeatMap::type, 5},
+		PersistentElementMax{"zoom", &ImGuiHeatMap::zoom, 4},
+	};
+};
+
+} // namespace openmsx
+
+#endif
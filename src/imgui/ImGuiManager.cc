@@ -9,6 +9,7 @@
 #include "ImGuiConsole.hh"
 #include "ImGuiDebugger.hh"
 #include "ImGuiDiskManipulator.hh"
+#include "ImGuiHeatMap.hh"
 #include "ImGuiHelp.hh"
 #include "ImGuiKeyboard.hh"
 #include "ImGuiMachine.hh"
@@ -181,6 +182,7 @@ ImGuiManager::ImGuiManager(Reactor& reactor_, SettingsConfig& settingsConfig)
 	character = std::make_unique<ImGuiCharacter>(*this);
 	sprite = std::make_unique<ImGuiSpriteViewer>(*this);
 	vdpRegs = std::make_unique<ImGuiVdpRegs>(*this);
+	heatMap = std::make_unique<ImGuiHeatMap>(*this);
 	palette = std::make_unique<ImGuiPalette>(*this);
 	osdIcons = std::make_unique<ImGuiOsdIcons>(*this);
 	openFile = std::make_unique<ImGuiOpenFile>(*this);
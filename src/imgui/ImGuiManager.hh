@@ -35,6 +35,7 @@ class ImGuiConnector;
 class ImGuiConsole;
 class ImGuiDebugger;
 class ImGuiDiskManipulator;
+class ImGuiHeatMap;
 class ImGuiHelp;
 class ImGuiKeyboard;
 class ImGuiMachine;
@@ -142,6 +143,7 @@ public:
 	std::unique_ptr<ImGuiCharacter> character;
 	std::unique_ptr<ImGuiSpriteViewer> sprite;
 	std::unique_ptr<ImGuiVdpRegs> vdpRegs;
+	std::unique_ptr<ImGuiHeatMap> heatMap;
 	std::unique_ptr<ImGuiPalette> palette;
 	std::unique_ptr<ImGuiReverseBar> reverseBar;
 	std::unique_ptr<ImGuiHelp> help;
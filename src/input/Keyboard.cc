@@ -6,6 +6,7 @@
 #include "Event.hh"
 #include "EventDistributor.hh"
 #include "InputEventFactory.hh"
+#include "MSXCPUInterface.hh"
 #include "MSXEventDistributor.hh"
 #include "MSXMotherBoard.hh"
 #include "ReverseManager.hh"
@@ -703,6 +704,8 @@ Keyboard::Keyboard(MSXMotherBoard& motherBoard,
 	, keyMatrixUpCmd  (commandController, stateChangeDistributor, scheduler_)
 	, keyMatrixDownCmd(commandController, stateChangeDistributor, scheduler_)
 	, keyTypeCmd      (commandController, stateChangeDistributor, scheduler_)
+	, keyBufCmd       (commandController, stateChangeDistributor, scheduler_,
+	                   motherBoard, matrix)
 	, msxcode2UnicodeCmd(commandController)
 	, unicode2MsxcodeCmd(commandController)
 	, capsLockAligner(eventDistributor, scheduler_)
@@ -1751,6 +1754,124 @@ void Keyboard::KeyInserter::reschedule(EmuTime::param time)
 }
 
 
+// class KeyBufInserter
+
+Keyboard::KeyBufInserter::KeyBufInserter(
+		CommandController& commandController_,
+		StateChangeDistributor& stateChangeDistributor_,
+		Scheduler& scheduler_,
+		MSXMotherBoard& motherBoard_, Matrix matrix)
+	: RecordedCommand(commandController_, stateChangeDistributor_,
+		scheduler_, "type_via_keybuf")
+	, Schedulable(scheduler_)
+	, motherBoard(motherBoard_)
+	, svi(matrix == Matrix::SVI)
+{
+}
+
+void Keyboard::KeyBufInserter::execute(
+	std::span<const TclObject> tokens, TclObject& /*result*/, EmuTime::param time)
+{
+	checkNumArgs(tokens, AtLeast{2}, "?-cancel? text");
+
+	// -release and -freq are accepted (and ignored), so that this command
+	// can be used as a drop-in replacement for 'type_via_keyboard'.
+	bool cancel = false;
+	bool release = false;
+	int freq = 0;
+	std::array info = {
+		flagArg("-cancel", cancel),
+		flagArg("-release", release),
+		valueArg("-freq", freq),
+	};
+	auto arguments = parseTclArgs(getInterpreter(), tokens.subspan(1), info);
+
+	if (cancel) {
+		text.clear();
+		removeSyncPoint();
+		return;
+	}
+	if (arguments.size() != 1) throw SyntaxError();
+
+	// Characters that don't exist in the MSX character set are replaced
+	// by a space. Control characters (like newline) are passed unchanged.
+	const auto& keyboard = OUTER(Keyboard, keyBufCmd);
+	const auto& msxChars = keyboard.unicodeKeymap.getMsxChars();
+	auto msx = msxChars.utf8ToMsx(arguments[0].getString(),
+		[](uint32_t u) { return (u < 0x20) ? uint8_t(u) : uint8_t(' '); });
+	text.append(msx.begin(), msx.end());
+
+	if (!text.empty() && !isActive()) {
+		fillBuffer(time);
+	}
+}
+
+std::string Keyboard::KeyBufInserter::help(std::span<const TclObject> /*tokens*/) const
+{
+	return "Type a string in the emulated MSX by putting it directly in the "
+	       "keyboard buffer in RAM. This is a lot faster than type_via_keyboard, "
+	       "but it only works in software that reads its input via the BIOS "
+	       "keyboard buffer, like MSX-BASIC.\n"
+	       "The buffer is refilled as soon as the MSX software takes characters "
+	       "out of it, so long texts go in as fast as the software can handle.\n"
+	       "Use -cancel to cancel a (long) in-progress type command.\n"
+	       "The options -release and -freq are ignored.";
+}
+
+void Keyboard::KeyBufInserter::tabCompletion(std::vector<std::string>& tokens) const
+{
+	using namespace std::literals;
+	static constexpr std::array options = {"-cancel"sv};
+	completeString(tokens, options);
+}
+
+void Keyboard::KeyBufInserter::fillBuffer(EmuTime::param time)
+{
+	// The BIOS keyboard buffer is a ring buffer [KEYBUF, BUFEND). The
+	// interrupt handler adds characters at PUTPNT, CHGET takes them from
+	// GETPNT. It's full when advancing PUTPNT would make it equal to GETPNT.
+	const word PUTPNT = svi ? 0xFA1A : 0xF3F8;
+	const word GETPNT = svi ? 0xFA1C : 0xF3FA;
+	const word KEYBUF = svi ? 0xFD8B : 0xFBF0;
+	const word BUFEND = svi ? 0xFDB3 : 0xFC18;
+
+	auto& interface = motherBoard.getCPUInterface();
+	auto peek16 = [&](word addr) {
+		return word(interface.peekMem(addr, time) |
+		            (interface.peekMem(word(addr + 1), time) << 8));
+	};
+	auto put = peek16(PUTPNT);
+	auto get = peek16(GETPNT);
+	// Before the BIOS has initialized its work area, these pointers
+	// contain garbage. Then don't touch anything and try again later.
+	if ((KEYBUF <= put) && (put < BUFEND) && (KEYBUF <= get) && (get < BUFEND)) {
+		size_t num = 0;
+		while (num < text.size()) {
+			auto next = word(put + 1);
+			if (next == BUFEND) next = KEYBUF;
+			if (next == get) break; // full
+			interface.writeMem(put, uint8_t(text[num++]), time);
+			put = next;
+		}
+		if (num) {
+			interface.writeMem(PUTPNT, uint8_t(put & 0xFF), time);
+			interface.writeMem(word(PUTPNT + 1), uint8_t(put >> 8), time);
+			text.erase(0, num);
+		}
+	}
+	if (!text.empty()) {
+		// Polling often is cheap (only while typing) and keeps the
+		// buffer filled, even for software that empties it quickly.
+		setSyncPoint(time + EmuDuration::hz(300));
+	}
+}
+
+void Keyboard::KeyBufInserter::executeUntil(EmuTime::param time)
+{
+	fillBuffer(time);
+}
+
+
 // Commands for conversion between msxcode <-> unicode.
 
 Keyboard::Msxcode2UnicodeCmd::Msxcode2UnicodeCmd(CommandController& commandController_)
@@ -2003,6 +2124,13 @@ void Keyboard::KeyInserter::serialize(Archive& ar, unsigned /*version*/)
 	}
 }
 
+template<typename Archive>
+void Keyboard::KeyBufInserter::serialize(Archive& ar, unsigned /*version*/)
+{
+	ar.template serializeBase<Schedulable>(*this);
+	ar.serialize("text", text);
+}
+
 // version 1: Initial version: {userKeyMatrix, dynKeymap, msxModifiers,
 //            msxKeyEventQueue} was intentionally not serialized. The reason
 //            was that after a loadstate, you want the MSX keyboard to reflect
@@ -2012,6 +2140,7 @@ void Keyboard::KeyInserter::serialize(Archive& ar, unsigned /*version*/)
 //            full state of the MSX keyboard, so now we do serialize it.
 // version 3: split cmdKeyMatrix into cmdKeyMatrix + typeKeyMatrix
 // version 4: changed 'dynKeymap' to 'lastUnicodeForKeycode'
+// version 5: added 'keyBufCmd'
 // TODO Is the assumption in version 1 correct (clear keyb state on load)?
 //      If it is still useful for 'regular' loadstate, then we could implement
 //      it by explicitly clearing the keyb state from the actual loadstate
@@ -2022,6 +2151,9 @@ void Keyboard::serialize(Archive& ar, unsigned version)
 {
 	ar.serialize("keyTypeCmd", keyTypeCmd,
 	             "cmdKeyMatrix", cmdKeyMatrix);
+	if (ar.versionAtLeast(version, 5)) {
+		ar.serialize("keyBufCmd", keyBufCmd);
+	}
 	if (ar.versionAtLeast(version, 3)) {
 		ar.serialize("typeKeyMatrix", typeKeyMatrix);
 	} else {
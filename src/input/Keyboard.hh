@@ -17,6 +17,7 @@
 #include <cstdint>
 #include <deque>
 #include <span>
+#include <string>
 #include <string_view>
 #include <vector>
 
@@ -178,6 +179,40 @@ private:
 		int typingFrequency = 15;
 	} keyTypeCmd;
 
+	/** Types text by putting it directly in the BIOS keyboard buffer,
+	  * instead of pressing keys in the keyboard matrix. This only works
+	  * for software that reads the keyboard via the BIOS (like MSX-BASIC),
+	  * but then it's a lot faster: the buffer is periodically topped up,
+	  * so the text goes in as fast as the MSX software consumes it.
+	  */
+	class KeyBufInserter final : public RecordedCommand, public Schedulable {
+	public:
+		KeyBufInserter(CommandController& commandController,
+			       StateChangeDistributor& stateChangeDistributor,
+			       Scheduler& scheduler,
+			       MSXMotherBoard& motherBoard, Matrix matrix);
+		[[nodiscard]] bool isActive() const { return pendingSyncPoint(); }
+		template<typename Archive>
+		void serialize(Archive& ar, unsigned version);
+
+	private:
+		void fillBuffer(EmuTime::param time);
+
+		// Command
+		void execute(std::span<const TclObject> tokens, TclObject& result,
+			     EmuTime::param time) override;
+		[[nodiscard]] std::string help(std::span<const TclObject> tokens) const override;
+		void tabCompletion(std::vector<std::string>& tokens) const override;
+
+		// Schedulable
+		void executeUntil(EmuTime::param time) override;
+
+	private:
+		MSXMotherBoard& motherBoard;
+		const bool svi; // SVI BIOS has its keyboard buffer at other addresses
+		std::string text; // in MSX character codes, not yet put in the buffer
+	} keyBufCmd;
+
 	struct Msxcode2UnicodeCmd final : public Command {
 		explicit Msxcode2UnicodeCmd(CommandController& commandController);
 		void execute(std::span<const TclObject> tokens, TclObject& result) override;
@@ -276,7 +311,7 @@ private:
 	  */
 	uint8_t locksOn = 0;
 };
-SERIALIZE_CLASS_VERSION(Keyboard, 4);
+SERIALIZE_CLASS_VERSION(Keyboard, 5);
 
 } // namespace openmsx
 
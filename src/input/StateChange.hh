@@ -26,6 +26,13 @@ public:
 		return time;
 	}
 
+	/** Only used by run-ahead, to move an already recorded event (a bit)
+	  * into the past. */
+	void setTime(EmuTime::param time_)
+	{
+		time = time_;
+	}
+
 	template<typename Archive>
 	void serialize(Archive& ar, unsigned /*version*/)
 	{
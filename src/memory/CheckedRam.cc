@@ -1,10 +1,13 @@
 #include "CheckedRam.hh"
 #include "MSXCPU.hh"
 #include "MSXMotherBoard.hh"
+#include "CPURegs.hh"
+#include "Debugger.hh"
 #include "DeviceConfig.hh"
 #include "GlobalSettings.hh"
 #include "StringSetting.hh"
 #include "narrow.hh"
+#include "ranges.hh"
 #include "xrange.hh"
 #include <cassert>
 
@@ -14,8 +17,12 @@ CheckedRam::CheckedRam(const DeviceConfig& config, const std::string& name,
                        static_string_view description, size_t size)
 	: ram(config, name, description, size)
 	, msxcpu(config.getMotherBoard().getCPU())
+	, umrLog(config.getMotherBoard().getDebugger().getUMRLog())
+	, umrCheck(config.getGlobalSettings().getUMRCheckSetting())
 	, umrCallback(config.getGlobalSettings().getUMRCallBackSetting())
+	, umrId(umrLog.registerRam(ram.getName()))
 {
+	umrCheck.attach(*this);
 	umrCallback.getSetting().attach(*this);
 	init();
 }
@@ -23,51 +30,65 @@ CheckedRam::CheckedRam(const DeviceConfig& config, const std::string& name,
 CheckedRam::~CheckedRam()
 {
 	umrCallback.getSetting().detach(*this);
+	umrCheck.detach(*this);
+}
+
+bool CheckedRam::isLineInitialized(size_t line) const
+{
+	if ((line + 1) * CacheLine::SIZE > ram.size()) [[unlikely]] {
+		// Partial last line (RAM size is not a multiple of the line
+		// size): never hand it out as a cache line, the CPU would
+		// access past the end of the RAM. Always go via read()/write().
+		return false;
+	}
+	return ranges::all_of(std::span{uninitialized}.subspan(line * WORDS_PER_LINE, WORDS_PER_LINE),
+	                      [](uint64_t w) { return w == 0; });
+}
+
+void CheckedRam::reportUMR(size_t addr)
+{
+	umrLog.hit(umrId, narrow<unsigned>(addr), msxcpu.getRegisters().getPC());
+	umrCallback.execute(narrow<int>(addr), ram.getName());
 }
 
 byte CheckedRam::read(size_t addr)
 {
-	if (size_t line = addr >> CacheLine::BITS;
-	    !completely_initialized_cacheline[line]) [[unlikely]] {
-		if (uninitialized[line][addr &  CacheLine::LOW]) [[unlikely]] {
-			umrCallback.execute(narrow<int>(addr), ram.getName());
-		}
+	if (uninitialized[addr / WORD_BITS] & (uint64_t(1) << (addr % WORD_BITS))) [[unlikely]] {
+		reportUMR(addr);
 	}
 	return ram[addr];
 }
 
 const byte* CheckedRam::getReadCacheLine(size_t addr) const
 {
-	return (completely_initialized_cacheline[addr >> CacheLine::BITS])
-	     ? &ram[addr] : nullptr;
+	return isLineInitialized(addr >> CacheLine::BITS) ? &ram[addr] : nullptr;
 }
 
 byte* CheckedRam::getWriteCacheLine(size_t addr) const
 {
-	return (completely_initialized_cacheline[addr >> CacheLine::BITS])
+	return isLineInitialized(addr >> CacheLine::BITS)
 	     ? const_cast<byte*>(&ram[addr]) : nullptr;
 }
 
 byte* CheckedRam::getRWCacheLines(size_t addr, size_t size) const
 {
-	// TODO optimize
-	size_t num = size >> CacheLine::BITS;
-	size_t first = addr >> CacheLine::BITS;
-	for (auto i : xrange(num)) {
-		if (!completely_initialized_cacheline[first + i]) {
-			return nullptr;
-		}
+	// [addr, addr + size) is aligned on cache lines, so on words as well
+	if (addr + size > ram.size()) [[unlikely]] {
+		return nullptr; // includes a partial last line
+	}
+	auto words = std::span{uninitialized}.subspan(addr / WORD_BITS, size / WORD_BITS);
+	if (!ranges::all_of(words, [](uint64_t w) { return w == 0; })) {
+		return nullptr;
 	}
 	return const_cast<byte*>(&ram[addr]);
 }
 
 void CheckedRam::write(size_t addr, const byte value)
 {
-	if (size_t line = addr >> CacheLine::BITS;
-	    !completely_initialized_cacheline[line]) [[unlikely]] {
-		uninitialized[line][addr & CacheLine::LOW] = false;
-		if (uninitialized[line].none()) [[unlikely]] {
-			completely_initialized_cacheline[line] = true;
+	auto& w = uninitialized[addr / WORD_BITS];
+	if (auto mask = uint64_t(1) << (addr % WORD_BITS); w & mask) [[unlikely]] {
+		w &= ~mask;
+		if ((w == 0) && isLineInitialized(addr >> CacheLine::BITS)) [[unlikely]] {
 			// This invalidates way too much stuff. But because
 			// (locally) we don't know exactly how this class ie
 			// being used in the MSXDevice, there's no easy way to
@@ -90,26 +111,32 @@ void CheckedRam::clear()
 
 void CheckedRam::init()
 {
-	auto lines = ram.size() / CacheLine::SIZE;
-	if (umrCallback.getValue().empty()) {
-		// there is no callback function,
-		// do as if everything is initialized
-		completely_initialized_cacheline.assign(lines, true);
-		// 'uninitialized' won't be accessed, so don't even allocate
+	auto lines = (ram.size() + CacheLine::SIZE - 1) / CacheLine::SIZE;
+	if (!umrCheck.getBoolean() && umrCallback.getValue().empty()) {
+		// checking is disabled, do as if everything is initialized
+		uninitialized.assign(lines * WORDS_PER_LINE, 0);
 	} else {
-		// new callback function, forget about initialized areas
-		completely_initialized_cacheline.assign(lines, false);
-
-		std::bitset<CacheLine::SIZE> allTrue;
-		allTrue.set();
-		uninitialized.assign(lines, allTrue);
+		// (re)enabled, forget about initialized areas
+		uninitialized.assign(lines * WORDS_PER_LINE, ~uint64_t(0));
+		// The bytes past the end of a partial last line don't exist,
+		// they can't be written, so don't mark them as uninitialized.
+		auto used = ram.size() % CacheLine::SIZE;
+		if (used != 0) {
+			auto tail = std::span{uninitialized}.last(WORDS_PER_LINE);
+			for (auto i : xrange(WORDS_PER_LINE)) {
+				auto first = i * WORD_BITS;
+				tail[i] = (used <= first) ? 0
+				        : (used >= first + WORD_BITS) ? ~uint64_t(0)
+				        : ((uint64_t(1) << (used - first)) - 1);
+			}
+		}
 	}
 	msxcpu.invalidateAllSlotsRWCache(0, 0x10000);
 }
 
 void CheckedRam::update(const Setting& setting) noexcept
 {
-	assert(&setting == &umrCallback.getSetting());
+	assert((&setting == &umrCheck) || (&setting == &umrCallback.getSetting()));
 	(void)setting;
 	init();
 }
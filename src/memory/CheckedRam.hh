@@ -6,14 +6,16 @@
 #include "CacheLine.hh"
 #include "Observer.hh"
 #include "openmsx.hh"
+#include <cstdint>
 #include <vector>
-#include <bitset>
 
 namespace openmsx {
 
+class BooleanSetting;
 class DeviceConfig;
 class MSXCPU;
 class Setting;
+class UMRLog;
 
 /**
  * This class keeps track of which bytes in the Ram have been written to. It
@@ -23,6 +25,14 @@ class Setting;
  * the turboR, only the normal memory mapper runs via CheckedRam. The RAM
  * accessed in DRAM mode or via the ROM mapper are unchecked! Note that there
  * is basically no overhead for using CheckedRam over Ram, thanks to Wouter.
+ *
+ * Checking is active when the 'umr_check' setting is enabled or when an
+ * 'umr_callback' is set. The administration is a shadow bitmap with one bit
+ * per byte, so all bits of a cache line can be tested with a few word
+ * operations. Cache lines that are completely initialized are accessed
+ * directly by the CPU (no checks needed anymore), the others go via read()
+ * and write(). Detected UMRs are collected in the (deduplicated) UMRLog of
+ * the debugger, see 'debug umr_log'.
  */
 class CheckedRam final : private Observer<Setting>
 {
@@ -55,17 +65,26 @@ public:
 	//void serialize(Archive& ar, unsigned version);
 
 private:
+	static constexpr size_t WORD_BITS = 64;
+	static constexpr size_t WORDS_PER_LINE = CacheLine::SIZE / WORD_BITS;
+
+	[[nodiscard]] bool isLineInitialized(size_t line) const;
+	void reportUMR(size_t addr);
 	void init();
 
 	// Observer<Setting>
 	void update(const Setting& setting) noexcept override;
 
 private:
-	std::vector<bool> completely_initialized_cacheline;
-	std::vector<std::bitset<CacheLine::SIZE>> uninitialized;
+	// one bit per byte, a set bit means: never written. All zero when
+	// checking is disabled.
+	std::vector<uint64_t> uninitialized;
 	Ram ram;
 	MSXCPU& msxcpu;
+	UMRLog& umrLog;
+	BooleanSetting& umrCheck;
 	TclCallback umrCallback;
+	unsigned umrId;
 };
 
 } // namespace openmsx
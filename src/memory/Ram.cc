@@ -8,12 +8,14 @@
 #include "HexDump.hh"
 #include "narrow.hh"
 #include "one_of.hh"
+#include "ranges.hh"
 #include "serialize.hh"
 
 #include <zlib.h>
 
 #include <algorithm>
 #include <bit>
+#include <cassert>
 #include <memory>
 
 namespace openmsx {
@@ -103,6 +105,18 @@ void RamDebuggable::write(unsigned address, byte value)
 	ram[address] = value;
 }
 
+void RamDebuggable::readBlock(unsigned address, std::span<byte> output)
+{
+	assert((address + output.size()) <= ram.size());
+	ranges::copy(std::span{&ram[address], output.size()}, output);
+}
+
+void RamDebuggable::writeBlock(unsigned address, std::span<const byte> input)
+{
+	assert((address + input.size()) <= ram.size());
+	ranges::copy(input, std::span{&ram[address], input.size()});
+}
+
 
 template<typename Archive>
 void Ram::serialize(Archive& ar, unsigned /*version*/)
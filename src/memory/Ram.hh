@@ -21,6 +21,8 @@ public:
 	              static_string_view description, Ram& ram);
 	byte read(unsigned address) override;
 	void write(unsigned address, byte value) override;
+	void readBlock(unsigned address, std::span<byte> output) override;
+	void writeBlock(unsigned address, std::span<const byte> input) override;
 private:
 	Ram& ram;
 };
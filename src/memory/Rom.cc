@@ -45,6 +45,8 @@ public:
 	[[nodiscard]] std::string_view getDescription() const override;
 	[[nodiscard]] byte read(unsigned address) override;
 	void write(unsigned address, byte value) override;
+	void readBlock(unsigned address, std::span<byte> output) override;
+	void writeBlock(unsigned address, std::span<const byte> input) override;
 	void moved(Rom& r);
 private:
 	Debugger& debugger;
@@ -186,19 +188,21 @@ void Rom::init(MSXMotherBoard& motherBoard, const XMLElement& config,
 				"inside a <rom> section are no longer "
 				"supported.");
 		}
-		try {
-			auto mmap = file.mmap();
-			rom = mmap;
-		} catch (FileException&) {
-			throw MSXException("Error reading ROM image: ", file.getURL());
-		}
-
 		// For file-based roms, calc sha1 via File::getSha1Sum(). It can
 		// possibly use the FilePool cache to avoid the calculation.
 		if (originalSha1.empty()) {
 			originalSha1 = filePool.getSha1Sum(file);
 		}
 
+		// Share the content with all other ROMs with the same sha1sum.
+		try {
+			auto& romStore = motherBoard.getReactor().getRomStore();
+			shared = romStore.get(file, originalSha1, fileType == FileType::SYSTEM_ROM);
+			rom = shared ? shared->data : file.mmap();
+		} catch (FileException&) {
+			throw MSXException("Error reading ROM image: ", file.getURL());
+		}
+
 		// verify SHA1
 		if (!checkSHA1(config)) {
 			motherBoard.getMSXCliComm().printWarning(
@@ -238,15 +242,13 @@ void Rom::init(MSXMotherBoard& motherBoard, const XMLElement& config,
 					Filename(p->getData(), context),
 					std::move(patch));
 			}
+			// Never patch in-place, the content may be shared (with
+			// other ROMs or with the decompress cache).
 			auto patchSize = patch->getSize();
-			if (patchSize <= rom.size()) {
-				patch->copyBlock(0, std::span{const_cast<uint8_t*>(rom.data()), rom.size()});
-			} else {
-				MemBuffer<byte> extendedRom2(patchSize);
-				patch->copyBlock(0, std::span{extendedRom2.data(), patchSize});
-				extendedRom = std::move(extendedRom2);
-				rom = std::span{extendedRom.data(), patchSize};
-			}
+			MemBuffer<byte> extendedRom2(patchSize);
+			patch->copyBlock(0, std::span{extendedRom2.data(), patchSize});
+			extendedRom = std::move(extendedRom2);
+			rom = std::span{extendedRom.data(), patchSize};
 
 			// calculated because it's different from original
 			actualSha1 = SHA1::calc(rom);
@@ -331,6 +333,7 @@ bool Rom::checkSHA1(const XMLElement& config) const
 Rom::Rom(Rom&& r) noexcept
 	: rom          (r.rom)
 	, extendedRom  (std::move(r.extendedRom))
+	, shared       (std::move(r.shared))
 	, file         (std::move(r.file))
 	, originalSha1 (r.originalSha1)
 	, actualSha1   (r.actualSha1)
@@ -419,6 +422,17 @@ void RomDebuggable::write(unsigned /*address*/, byte /*value*/)
 	// ignore
 }
 
+void RomDebuggable::readBlock(unsigned address, std::span<byte> output)
+{
+	assert((address + output.size()) <= getSize());
+	ranges::copy(std::span{&(*rom)[address], output.size()}, output);
+}
+
+void RomDebuggable::writeBlock(unsigned /*address*/, std::span<const byte> /*input*/)
+{
+	// ignore
+}
+
 void RomDebuggable::moved(Rom& r)
 {
 	rom = &r;
@@ -3,6 +3,7 @@
 
 #include "File.hh"
 #include "MemBuffer.hh"
+#include "RomStore.hh"
 #include "sha1.hh"
 #include "static_string_view.hh"
 #include "openmsx.hh"
@@ -59,6 +60,7 @@ private:
 	// !! update the move constructor when changing these members !!
 	std::span<const byte> rom;
 	MemBuffer<byte> extendedRom;
+	std::shared_ptr<const RomStore::Entry> shared; // can be nullptr
 
 	File file; // can be a closed file
 
@@ -0,0 +1,90 @@
+#include "RomStore.hh"
+
+#include "FileException.hh"
+#include "FileOperations.hh"
+
+#include <cstdio>
+
+namespace openmsx {
+
+std::shared_ptr<const RomStore::Entry> RomStore::get(
+	File& file, const Sha1Sum& sha1, bool persistent)
+{
+	if (auto it = entries.find(sha1); it != entries.end()) {
+		if (auto entry = it->second.lock()) return entry;
+	}
+
+	// Get a File object that's owned by the store (this content can
+	// outlive the Rom that first requested it).
+	File sharedFile;
+	if (auto local = file.getLocalReference(); !local.empty()) {
+		sharedFile = File(std::move(local));
+	} else if (persistent) {
+		try {
+			sharedFile = getCachedFile(file, sha1);
+		} catch (FileException&) {
+			// The cache is only an optimization (e.g. the directory
+			// could be read-only), use the decompressed data instead.
+			return nullptr;
+		}
+	} else {
+		return nullptr;
+	}
+
+	auto entry = std::make_shared<Entry>();
+	entry->file = std::move(sharedFile);
+	entry->data = entry->file.mmap();
+
+	std::erase_if(entries, [](const auto& e) { return e.second.expired(); });
+	entries.insert_or_assign(sha1, entry);
+	return entry;
+}
+
+File RomStore::getCachedFile(File& file, const Sha1Sum& sha1)
+{
+	auto dir = FileOperations::join(FileOperations::getUserOpenMSXDir(), "romcache");
+	auto filename = FileOperations::join(dir, sha1.toString());
+	try {
+		// Don't blindly trust the cache, it could be truncated or
+		// modified. Hashing the (small) ROM image is still a lot
+		// cheaper than decompressing it.
+		File cached(filename);
+		if (SHA1::calc(cached.mmap()) == sha1) return cached;
+	} catch (FileException&) {
+		// not yet in the cache
+	}
+
+	// Write to a temporary file, then rename, so that other openMSX
+	// processes never see a partially written file.
+	auto data = file.mmap();
+	FileOperations::mkdirp(dir);
+	std::string tmpName;
+	{
+		auto fp = FileOperations::openUniqueFile(dir, tmpName);
+		bool ok = fp &&
+		          (fwrite(data.data(), 1, data.size(), fp.get()) == data.size()) &&
+		          (fflush(fp.get()) == 0);
+		// Close explicitly (instead of via the unique_ptr) to check for
+		// write errors that only show up when closing.
+		if (fp && (fclose(fp.release()) != 0)) ok = false;
+		if (!ok) {
+			FileOperations::unlink(tmpName);
+			throw FileException("Couldn't write ROM cache file ", tmpName);
+		}
+	}
+	// This also replaces a (corrupt) file that failed the check above.
+	if (std::rename(tmpName.c_str(), filename.c_str()) != 0) {
+		// e.g. on windows, when another process already created it, or
+		// the old (corrupt) file is still in use
+		FileOperations::unlink(tmpName);
+	}
+	File result(filename);
+	if (SHA1::calc(result.mmap()) != sha1) {
+		// Couldn't replace a corrupt cache file, fall back to the
+		// decompressed data of the original file.
+		throw FileException("Corrupt ROM cache file ", filename);
+	}
+	return result;
+}
+
+} // namespace openmsx
@@ -0,0 +1,54 @@
+#ifndef ROMSTORE_HH
+#define ROMSTORE_HH
+
+#include "File.hh"
+#include "sha1.hh"
+
+#include <cstdint>
+#include <map>
+#include <memory>
+#include <span>
+
+namespace openmsx {
+
+/** Content-addressed (by sha1sum) store of read-only ROM images.
+  *
+  * ROM images with the same content share a single mapping, e.g. the system
+  * ROMs of several instances of the same machine. So each additional machine
+  * only adds its RAM/VRAM/... to the memory usage.
+  *
+  * Compressed system ROMs (.gz or .zip) are decompressed once into a cache
+  * directory (named after their sha1sum). Later this decompressed file is
+  * mmap'ed directly, after verifying its sha1sum (a corrupt file is replaced).
+  * This avoids decompressing in every new openMSX process, and the OS can
+  * share the (clean) pages of the mapping between processes.
+  */
+class RomStore
+{
+public:
+	struct Entry {
+		File file;
+		std::span<const uint8_t> data;
+	};
+
+	/** Get the shared content of 'file', whose sha1sum must be 'sha1'.
+	  * Returns nullptr when the content can't be shared (compressed, non
+	  * persistent, or the cache directory can't be used), then the caller
+	  * should mmap 'file' itself.
+	  * @param persistent Allow to store (decompressed) content in the cache
+	  *                   directory. Only used for system ROMs.
+	  * @throws FileException
+	  */
+	[[nodiscard]] std::shared_ptr<const Entry> get(
+		File& file, const Sha1Sum& sha1, bool persistent);
+
+private:
+	[[nodiscard]] static File getCachedFile(File& file, const Sha1Sum& sha1);
+
+private:
+	std::map<Sha1Sum, std::weak_ptr<const Entry>> entries;
+};
+
+} // namespace openmsx
+
+#endif
@@ -6,6 +6,8 @@
 #include "XMLException.hh"
 #include "DeltaBlock.hh"
 #include "MemBuffer.hh"
+#include "File.hh"
+#include "FileException.hh"
 #include "FileOperations.hh"
 #include "Version.hh"
 #include "Date.hh"
@@ -14,6 +16,7 @@
 #include "stl.hh"
 #include "build-info.hh"
 
+#include <algorithm>
 #include <bit>
 #include "cstdiop.hh" // for dup()
 #include <cstdint>
@@ -188,10 +191,25 @@ MemBuffer<uint8_t> MemOutputArchive::releaseBuffer(size_t& size)
 
 ////
 
+void MemInputArchive::truncated()
+{
+	throw MSXException("Corrupt savestate: unexpected end of data.");
+}
+
+void MemInputArchive::loadCollectionSize(int& n)
+{
+	load(n);
+	// Every element takes at least one byte. Checking this avoids huge
+	// allocations (in prepare()) for corrupt sizes.
+	if (n < 0) truncated();
+	check(size_t(n));
+}
+
 void MemInputArchive::load(std::string& s)
 {
 	size_t length;
 	load(length);
+	check(length); // before resize()
 	s.resize(length);
 	if (length) {
 		get(s.data(), length);
@@ -202,6 +220,7 @@ string_view MemInputArchive::loadStr()
 {
 	size_t length;
 	load(length);
+	check(length);
 	const uint8_t* p = buffer.getCurrentPos();
 	buffer.skip(length);
 	return {std::bit_cast<const char*>(p), length};
@@ -219,12 +238,14 @@ void MemOutputArchive::serialize_blob(const char* /*tag*/, std::span<const uint8
                                       bool diff)
 {
 	// Delta-compress in-memory blobs, see DeltaBlock.hh for more details.
-	if (data.size() > SMALL_SIZE) {
-		auto deltaBlockIdx = unsigned(deltaBlocks.size());
+	// Standalone archives are compressed as a whole, see
+	// writeBinarySaveState().
+	if (deltaBlocks && (data.size() > SMALL_SIZE)) {
+		auto deltaBlockIdx = unsigned(deltaBlocks->size());
 		save(deltaBlockIdx); // see comment below in MemInputArchive
-		deltaBlocks.push_back(diff
-			? lastDeltaBlocks.createNew(data.data(), data)
-			: lastDeltaBlocks.createNullDiff(data.data(), data));
+		deltaBlocks->push_back(diff
+			? lastDeltaBlocks->createNew(data.data(), data)
+			: lastDeltaBlocks->createNullDiff(data.data(), data));
 	} else {
 		auto buf = buffer.allocate(data.size());
 		ranges::copy(data, buf);
@@ -234,7 +255,7 @@ void MemOutputArchive::serialize_blob(const char* /*tag*/, std::span<const uint8
 void MemInputArchive::serialize_blob(const char* /*tag*/, std::span<uint8_t> data,
                                      bool /*diff*/)
 {
-	if (data.size() > SMALL_SIZE) {
+	if (!standalone && (data.size() > SMALL_SIZE)) {
 		// Usually blobs are saved in the same order as they are loaded
 		// (via the serialize_blob() methods in respectively
 		// MemOutputArchive and MemInputArchive). In that case keeping
@@ -246,6 +267,7 @@ void MemInputArchive::serialize_blob(const char* /*tag*/, std::span<uint8_t> dat
 		unsigned deltaBlockIdx; load(deltaBlockIdx);
 		deltaBlocks[deltaBlockIdx]->apply(data);
 	} else {
+		check(data.size());
 		ranges::copy(std::span{buffer.getCurrentPos(), data.size()}, data);
 		buffer.skip(data.size());
 	}
@@ -253,6 +275,117 @@ void MemInputArchive::serialize_blob(const char* /*tag*/, std::span<uint8_t> dat
 
 ////
 
+// Binary savestate files, see serialize.hh for the file layout.
+//
+// The archive content is raw host-endian data (e.g. 'size_t' string lengths),
+// so the header also stores the properties of the platform that wrote it.
+static constexpr std::array<char, 8> BINARY_MAGIC = {'o','p','e','n','M','S','X','\x1a'};
+static constexpr uint32_t BINARY_FORMAT_VERSION = 1;
+// Blocks are compressed independently. Big enough to get a good compression
+// ratio, small enough to not need a huge intermediate buffer.
+static constexpr size_t BINARY_BLOCK_SIZE = 1024 * 1024;
+
+struct BinarySaveStateHeader {
+	std::array<char, 8> magic = BINARY_MAGIC;
+	uint32_t formatVersion = BINARY_FORMAT_VERSION;
+	uint16_t endianCheck = 0x1234;
+	uint8_t sizeofSizeT = sizeof(size_t);
+	uint8_t reserved = 0;
+	uint64_t totalSize = 0;
+};
+struct BinarySaveStateBlock {
+	uint32_t rawSize;
+	uint32_t compressedSize;
+};
+
+bool isBinarySaveState(const std::string& filename)
+{
+	try {
+		// Open without transparent decompression: the (XML) savestates
+		// are gzipped, and we need to see the raw bytes.
+		File file(filename, "rb");
+		if (file.getSize() < sizeof(BINARY_MAGIC)) return false;
+		std::array<char, 8> magic;
+		file.read(std::span<char>{magic});
+		return magic == BINARY_MAGIC;
+	} catch (FileException&) {
+		return false;
+	}
+}
+
+void writeBinarySaveState(const std::string& filename, std::span<const uint8_t> data)
+{
+	File file(filename, File::OpenMode::TRUNCATE);
+	BinarySaveStateHeader header;
+	header.totalSize = data.size();
+	file.write(std::span{&header, 1});
+
+	// Compress one block at a time. Use a fast compression level,
+	// speed matters more than size here.
+	auto bufSize = compressBound(uLong(BINARY_BLOCK_SIZE));
+	MemBuffer<uint8_t> buf(bufSize);
+	while (!data.empty()) {
+		auto raw = data.first(std::min(data.size(), BINARY_BLOCK_SIZE));
+		data = data.subspan(raw.size());
+		auto dstLen = uLongf(bufSize);
+		if (compress2(buf.data(), &dstLen, raw.data(), uLong(raw.size()), 1) != Z_OK) {
+			throw MSXException("Error while compressing savestate.");
+		}
+		BinarySaveStateBlock block{uint32_t(raw.size()), uint32_t(dstLen)};
+		file.write(std::span{&block, 1});
+		file.write(std::span{buf.data(), dstLen});
+	}
+}
+
+MemBuffer<uint8_t> readBinarySaveState(const std::string& filename, size_t& size)
+{
+	File file(filename, "rb");
+	BinarySaveStateHeader header;
+	file.read(std::span{&header, 1});
+	if (header.magic != BINARY_MAGIC) {
+		throw MSXException("Not a binary savestate.");
+	}
+	if (header.formatVersion > BINARY_FORMAT_VERSION) {
+		throw MSXException(
+			"Binary savestate format version ", header.formatVersion,
+			" is not supported (only up to version ",
+			BINARY_FORMAT_VERSION, ").");
+	}
+	if ((header.endianCheck != 0x1234) || (header.sizeofSizeT != sizeof(size_t))) {
+		throw MSXException(
+			"This binary savestate was created on a different type "
+			"of platform, it can only be loaded there.");
+	}
+	auto fileSize = file.getSize();
+	if (header.totalSize > fileSize * 1032) { // sanity check, zlib's best ratio is ~1032:1
+		throw MSXException("Corrupt binary savestate.");
+	}
+
+	size = header.totalSize;
+	MemBuffer<uint8_t> result(size);
+	MemBuffer<uint8_t> buf;
+	size_t pos = 0;
+	while (pos < size) {
+		BinarySaveStateBlock block;
+		file.read(std::span{&block, 1});
+		if ((block.rawSize == 0) || (block.rawSize > (size - pos)) ||
+		    (block.compressedSize > (fileSize - file.getPos()))) {
+			throw MSXException("Corrupt binary savestate.");
+		}
+		buf.resize(block.compressedSize);
+		file.read(std::span{buf.data(), block.compressedSize});
+		auto dstLen = uLongf(block.rawSize);
+		if ((uncompress(&result[pos], &dstLen, buf.data(), uLong(block.compressedSize)) != Z_OK) ||
+		    (dstLen != block.rawSize)) {
+			throw MSXException("Error while decompressing savestate.");
+		}
+		pos += block.rawSize;
+	}
+	return result;
+}
+
+////
+
 XmlOutputArchive::XmlOutputArchive(zstring_view filename_)
 	: filename(filename_)
 	, writer(*this)
@@ -102,7 +102,7 @@ public:
 	 * See also serializeBase() above.
 	 *
 	 * The difference between serializeBase() and serializeInlinedBase()
-	 * is only relevant for versioned archives (see NEED_VERSION, e.g.
+	 * is only relevant for versioned archives (see needVersion(), e.g.
 	 * XML archives). In XML archives serializeBase() will put the base
 	 * class in a new subtag, serializeInlinedBase() puts the members
 	 * of the base class (inline) in the current tag. The advantage
@@ -229,7 +229,7 @@ public:
 	// be used by the serialization framework.
 
 	/** Does this archive store version information. */
-	static constexpr bool NEED_VERSION = true;
+	[[nodiscard]] bool needVersion() const { return true; }
 
 	/** Is this a reverse-snapshot? */
 	[[nodiscard]] bool isReverseSnapshot() const { return false; }
@@ -573,6 +573,15 @@ public:
 	void serialize_blob(const char* tag, std::span<uint8_t> data,
 	                    bool diff = true);
 
+	/** Load the size of a variable sized collection (only used by
+	 * archives that can't count children). Archives that read untrusted
+	 * data can validate it.
+	 */
+	void loadCollectionSize(int& n)
+	{
+		this->self().serialize("size", n);
+	}
+
 	template<typename T>
 	void serialize(const char* tag, T& t)
 	{
@@ -657,18 +666,26 @@ public:
 	MemOutputArchive(LastDeltaBlocks& lastDeltaBlocks_,
 	                 std::vector<std::shared_ptr<DeltaBlock>>& deltaBlocks_,
 			 bool reverseSnapshot_)
-		: lastDeltaBlocks(lastDeltaBlocks_)
-		, deltaBlocks(deltaBlocks_)
+		: lastDeltaBlocks(&lastDeltaBlocks_)
+		, deltaBlocks(&deltaBlocks_)
 		, reverseSnapshot(reverseSnapshot_)
 	{
 	}
 
+	/** Create a standalone archive, used for binary savestate files (see
+	  * writeBinarySaveState()). Unlike the in-memory (reverse) snapshots
+	  * this stores the class versions, so that a later openMSX version
+	  * can still load it, and it stores blobs inline instead of as
+	  * delta blocks.
+	  */
+	MemOutputArchive() = default;
+
 	~MemOutputArchive()
 	{
 		assert(openSections.empty());
 	}
 
-	static constexpr bool NEED_VERSION = false;
+	[[nodiscard]] bool needVersion() const { return !deltaBlocks; }
 	[[nodiscard]] bool isReverseSnapshot() const { return reverseSnapshot; }
 
 	template<typename T> void save(const T& t)
@@ -758,9 +775,9 @@ private:
 private:
 	OutputBuffer buffer;
 	std::vector<size_t> openSections;
-	LastDeltaBlocks& lastDeltaBlocks;
-	std::vector<std::shared_ptr<DeltaBlock>>& deltaBlocks;
-	const bool reverseSnapshot;
+	LastDeltaBlocks* lastDeltaBlocks = nullptr;            // nullptr when standalone
+	std::vector<std::shared_ptr<DeltaBlock>>* deltaBlocks = nullptr; // idem
+	const bool reverseSnapshot = false;
 };
 
 class MemInputArchive final : public InputArchiveBase<MemInputArchive>
@@ -773,20 +790,29 @@ public:
 	{
 	}
 
-	static constexpr bool NEED_VERSION = false;
-	[[nodiscard]] inline bool versionAtLeast(unsigned /*actual*/, unsigned /*required*/) const
+	/** Load a standalone archive, see MemOutputArchive(). */
+	explicit MemInputArchive(std::span<const uint8_t> data)
+		: buffer(data.data(), data.size())
+		, standalone(true)
 	{
-		return true;
 	}
-	[[nodiscard]] inline bool versionBelow(unsigned /*actual*/, unsigned /*required*/) const
+
+	[[nodiscard]] bool needVersion() const { return standalone; }
+	// For non-standalone archives 'actual' is always the latest version.
+	[[nodiscard]] inline bool versionAtLeast(unsigned actual, unsigned required) const
 	{
-		return false;
+		return actual >= required;
+	}
+	[[nodiscard]] inline bool versionBelow(unsigned actual, unsigned required) const
+	{
+		return actual < required;
 	}
 
 	template<typename T> void load(T& t)
 	{
 		get(&t, sizeof(t));
 	}
+	void loadCollectionSize(int& n);
 	inline void loadChar(char& c)
 	{
 		load(c);
@@ -808,6 +834,7 @@ public:
 	ALWAYS_INLINE void serialize(const char* /*tag*/, std::array<T, N>& t)
 		requires(SerializeAsMemcpy<T>::value)
 	{
+		check(N * sizeof(T));
 		buffer.read(t.data(), N * sizeof(T));
 	}
 
@@ -816,14 +843,27 @@ public:
 		size_t num;
 		load(num);
 		if (skip) {
+			check(num);
 			buffer.skip(num);
 		}
 	}
 
 private:
+	// Standalone archives are loaded from (untrusted) files, so all reads
+	// are bounds checked. In-memory reverse snapshots are trusted, for
+	// those InputBuffer only asserts.
+	void check(size_t len) const
+	{
+		if (standalone && (len > buffer.remaining())) [[unlikely]] {
+			truncated();
+		}
+	}
+	[[noreturn]] static void truncated();
+
 	void get(void* data, size_t len)
 	{
 		if (len) {
+			check(len);
 			buffer.read(data, len);
 		}
 	}
@@ -833,7 +873,10 @@ private:
 	ALWAYS_INLINE void serialize_group(const TUPLE& tuple)
 	{
 		auto read = [&](auto* p) { buffer.read(p, sizeof(*p)); };
-		std::apply([&](auto&&... args) { (read(args), ...); }, tuple);
+		std::apply([&](auto&&... args) {
+			check((size_t(0) + ... + sizeof(*args)));
+			(read(args), ...);
+		}, tuple);
 	}
 	template<typename TUPLE, typename T, typename ...Args>
 	ALWAYS_INLINE void serialize_group(const TUPLE& tuple, const char* tag, T& t, Args&& ...args)
@@ -850,8 +893,25 @@ private:
 private:
 	InputBuffer buffer;
 	std::span<const std::shared_ptr<DeltaBlock>> deltaBlocks;
+	bool standalone = false;
 };
 
+/** Binary savestate files.
+  *
+  * The state is serialized with a standalone MemOutputArchive. The resulting
+  * buffer (the whole state is kept in memory) is split in blocks which are
+  * compressed independently, so (de)compression only needs a small
+  * intermediate buffer. This is a lot faster (and gives smaller files) than
+  * the XML savestates. Those are still the default
+  * because they're portable between platforms and easier to debug.
+  *
+  * File layout: a header (magic, format version, platform properties and
+  * total size), followed by blocks of {rawSize, compressedSize, data}.
+  */
+[[nodiscard]] bool isBinarySaveState(const std::string& filename);
+void writeBinarySaveState(const std::string& filename, std::span<const uint8_t> data);
+[[nodiscard]] MemBuffer<uint8_t> readBinarySaveState(const std::string& filename, size_t& size);
+
 ////
 
 class XmlOutputArchive final : public OutputArchiveBase<XmlOutputArchive>
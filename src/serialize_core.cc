@@ -26,10 +26,16 @@ void pointerError(unsigned id)
 		latestVersion, ").");
 }
 
-unsigned loadVersionHelper(MemInputArchive& /*ar*/, const char* /*className*/,
-                           unsigned /*latestVersion*/)
+unsigned loadVersionHelper(MemInputArchive& ar, const char* className,
+                           unsigned latestVersion)
 {
-	UNREACHABLE;
+	assert(ar.needVersion());
+	unsigned version;
+	ar.load(version);
+	if (version > latestVersion) [[unlikely]] {
+		versionError(className, latestVersion, version);
+	}
+	return version;
 }
 
 unsigned loadVersionHelper(XmlInputArchive& ar, const char* className,
@@ -426,7 +426,7 @@ template<typename T> struct ClassSaver
 		}
 
 		unsigned version = SerializeClassVersion<T>::value;
-		if ((version != 0) && ar.NEED_VERSION) {
+		if ((version != 0) && ar.needVersion()) {
 			if (!ar.CAN_HAVE_OPTIONAL_ATTRIBUTES ||
 			    (version != 1)) {
 				ar.attribute("version", version);
@@ -574,7 +574,7 @@ unsigned loadVersionHelper(XmlInputArchive& ar, const char* className,
 template<typename T, typename Archive> unsigned loadVersion(Archive& ar)
 {
 	unsigned latestVersion = SerializeClassVersion<T>::value;
-	if ((latestVersion != 0) && ar.NEED_VERSION) {
+	if ((latestVersion != 0) && ar.needVersion()) {
 		return loadVersionHelper(ar, typeid(T).name(), latestVersion);
 	} else {
 		return latestVersion;
@@ -754,7 +754,7 @@ template<typename TC> struct CollectionLoader
 			if constexpr (Archive::CAN_COUNT_CHILDREN) {
 				n = ar.countChildren();
 			} else {
-				ar.serialize("size", n);
+				ar.loadCollectionSize(n);
 			}
 		}
 		sac::prepare(tc, n);
@@ -7,8 +7,11 @@
 #include "CliComm.hh"
 #include "CommandController.hh"
 #include "MSXException.hh"
+#include "Reactor.hh"
+#include "TclObject.hh"
 
 #include "one_of.hh"
+#include "outer.hh"
 #include "stl.hh"
 #include "unreachable.hh"
 
@@ -50,6 +53,7 @@ Mixer::Mixer(Reactor& reactor_, CommandController& commandController_)
 	, samplesSetting(
 		commandController, "samples",
 		"mixer samples", defaultSamples, 64, 8192)
+	, soundBufferInfo(reactor.getOpenMSXInfoCommand())
 {
 	muteSetting       .attach(*this);
 	frequencySetting  .attach(*this);
@@ -170,4 +174,34 @@ void Mixer::update(const Setting& setting) noexcept
 	}
 }
 
+
+// class SoundBufferInfo
+
+Mixer::SoundBufferInfo::SoundBufferInfo(InfoCommand& openMSXInfoCommand)
+	: InfoTopic(openMSXInfoCommand, "sound_buffer")
+{
+}
+
+void Mixer::SoundBufferInfo::execute(
+	std::span<const TclObject> tokens, TclObject& result) const
+{
+	checkNumArgs(tokens, 2, "");
+	const auto& driver = *OUTER(Mixer, soundBufferInfo).driver;
+	auto fill = driver.getBufferFill();
+	auto frequency = driver.getFrequency();
+	result.addDictKeyValues("filled",    narrow<int>(fill.filled),
+	                        "target",    narrow<int>(fill.target),
+	                        "capacity",  narrow<int>(fill.capacity),
+	                        "latency",   double(fill.filled) * 1000.0 / frequency, // in ms
+	                        "underruns", narrow<int>(driver.getUnderrunCount()));
+}
+
+std::string Mixer::SoundBufferInfo::help(std::span<const TclObject> /*tokens*/) const
+{
+	return "Returns a dict with the fill level of the sound output buffer: "
+	       "'filled', 'target' and 'capacity' (in samples), the resulting "
+	       "'latency' (in ms), and the number of buffer 'underruns' (the "
+	       "sound device needed samples but none were available).\n";
+}
+
 } // namespace openmsx
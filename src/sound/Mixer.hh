@@ -4,6 +4,7 @@
 #include "BooleanSetting.hh"
 #include "EnumSetting.hh"
 #include "IntegerSetting.hh"
+#include "InfoTopic.hh"
 
 #include "Observer.hh"
 
@@ -54,6 +55,7 @@ public:
 
 	[[nodiscard]] IntegerSetting& getMasterVolume() { return masterVolume; }
 	[[nodiscard]] BooleanSetting& getMuteSetting() { return muteSetting; }
+	[[nodiscard]] SoundDriver& getSoundDriver() { return *driver; }
 
 private:
 	void reloadDriver();
@@ -75,6 +77,13 @@ private:
 	IntegerSetting frequencySetting;
 	IntegerSetting samplesSetting;
 
+	struct SoundBufferInfo final : InfoTopic {
+		explicit SoundBufferInfo(InfoCommand& openMSXInfoCommand);
+		void execute(std::span<const TclObject> tokens,
+		             TclObject& result) const override;
+		[[nodiscard]] std::string help(std::span<const TclObject> tokens) const override;
+	} soundBufferInfo;
+
 	int muteCount = 0;
 };
 
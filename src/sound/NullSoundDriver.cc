@@ -24,4 +24,18 @@ void NullSoundDriver::uploadBuffer(std::span<const StereoFloat> /*buffer*/)
 {
 }
 
+SoundDriver::BufferFill NullSoundDriver::getBufferFill() const
+{
+	return {};
+}
+
+void NullSoundDriver::setTargetFill(unsigned /*samples*/)
+{
+}
+
+unsigned NullSoundDriver::getUnderrunCount() const
+{
+	return 0;
+}
+
 } // namespace openmsx
@@ -15,6 +15,10 @@ public:
 	[[nodiscard]] unsigned getSamples() const override;
 
 	void uploadBuffer(std::span<const StereoFloat> buffer) override;
+
+	[[nodiscard]] BufferFill getBufferFill() const override;
+	void setTargetFill(unsigned samples) override;
+	[[nodiscard]] unsigned getUnderrunCount() const override;
 };
 
 } // namespace openmsx
@@ -40,8 +40,8 @@ SDLSoundDriver::SDLSoundDriver(Reactor& reactor_,
 	frequency = obtained.freq;
 	fragmentSize = obtained.samples;
 
-	mixBufferSize = narrow<unsigned>(3 * (obtained.size / sizeof(StereoFloat)) + 1);
-	mixBuffer.resize(mixBufferSize);
+	ring.resize(4 * fragmentSize);
+	setTargetFill(0);
 	reInit();
 }
 
@@ -53,8 +53,7 @@ SDLSoundDriver::~SDLSoundDriver()
 void SDLSoundDriver::reInit()
 {
 	SDL_LockAudioDevice(deviceID);
-	readIdx  = 0;
-	writeIdx = 0;
+	ring.clear();
 	SDL_UnlockAudioDevice(deviceID);
 }
 
@@ -93,81 +92,58 @@ void SDLSoundDriver::audioCallbackHelper(void* userdata, uint8_t* strm, int len)
 		                        len / (2 * sizeof(float))});
 }
 
-unsigned SDLSoundDriver::getBufferFilled() const
-{
-	int result = narrow_cast<int>(writeIdx - readIdx);
-	if (result < 0) result += narrow<int>(mixBufferSize);
-	assert((0 <= result) && (narrow<unsigned>(result) < mixBufferSize));
-	return result;
-}
-
-unsigned SDLSoundDriver::getBufferFree() const
-{
-	// we can't distinguish completely filled from completely empty
-	// (in both cases readIx would be equal to writeIdx), so instead
-	// we define full as '(writeIdx + 1) == readIdx'.
-	unsigned result = mixBufferSize - 1 - getBufferFilled();
-	assert(narrow_cast<int>(result) >= 0);
-	assert(result < mixBufferSize);
-	return result;
-}
-
 void SDLSoundDriver::audioCallback(std::span<StereoFloat> stream)
 {
-	auto len = stream.size();
-
-	size_t available = getBufferFilled();
-	auto num = narrow<unsigned>(std::min(len, available));
-	if ((readIdx + num) < mixBufferSize) {
-		ranges::copy(std::span{&mixBuffer[readIdx], num}, stream);
-		readIdx += num;
-	} else {
-		unsigned len1 = mixBufferSize - readIdx;
-		ranges::copy(std::span{&mixBuffer[readIdx], len1}, stream);
-		unsigned len2 = num - len1;
-		ranges::copy(std::span{&mixBuffer[0], len2}, stream.subspan(len1));
-		readIdx = len2;
-	}
-	auto missing = narrow_cast<ptrdiff_t>(len - available);
-	if (missing > 0) {
+	// Runs on the SDL audio thread: never block here.
+	auto num = ring.read(stream);
+	if (num < stream.size()) {
 		// buffer underrun
-		ranges::fill(subspan(stream, available, missing), StereoFloat{});
+		ranges::fill(stream.subspan(num), StereoFloat{});
+		underruns.fetch_add(1, std::memory_order_relaxed);
 	}
 }
 
 void SDLSoundDriver::uploadBuffer(std::span<const StereoFloat> buffer)
 {
-	SDL_LockAudioDevice(deviceID);
-	unsigned free = getBufferFree();
-	if (buffer.size() > free) {
-		auto* board = reactor.getMotherBoard();
-		if (board && !board->getMSXMixer().isSynchronousMode() && // when not recording
-		    reactor.getGlobalSettings().getThrottleManager().isThrottled()) {
-			do {
-				SDL_UnlockAudioDevice(deviceID);
-				Timer::sleep(5000); // 5ms
-				SDL_LockAudioDevice(deviceID);
-				board->getRealTime().resync();
-				free = getBufferFree();
-			} while (buffer.size() > free);
-		} else {
-			// drop excess samples
-			buffer = buffer.subspan(0, free);
+	auto* board = reactor.getMotherBoard();
+	if (board && !board->getMSXMixer().isSynchronousMode() && // when not recording
+	    reactor.getGlobalSettings().getThrottleManager().isThrottled()) {
+		// Wait until the audio thread has consumed enough samples to
+		// stay around the target fill level. The sleep time is derived
+		// from the measured fill level, so this paces the emulation to
+		// the audio clock without keeping more latency than needed.
+		auto limit = std::min(std::max<size_t>(targetFill, buffer.size()),
+		                      ring.capacity());
+		while (true) {
+			auto filled = ring.size();
+			if ((filled + buffer.size()) <= limit) break;
+			auto excess = filled + buffer.size() - limit;
+			Timer::sleep(excess * 1000000 / frequency); // in us
+			board->getRealTime().resync();
 		}
 	}
-	assert(buffer.size() <= free);
-	if ((writeIdx + buffer.size()) < mixBufferSize) {
-		ranges::copy(buffer, &mixBuffer[writeIdx]);
-		writeIdx += narrow<unsigned>(buffer.size());
-	} else {
-		unsigned len1 = mixBufferSize - writeIdx;
-		ranges::copy(buffer.subspan(0, len1), &mixBuffer[writeIdx]);
-		unsigned len2 = narrow<unsigned>(buffer.size()) - len1;
-		ranges::copy(buffer.subspan(len1, len2), &mixBuffer[0]);
-		writeIdx = len2;
-	}
+	// When not throttled, excess samples are dropped.
+	ring.write(buffer);
+}
 
-	SDL_UnlockAudioDevice(deviceID);
+SoundDriver::BufferFill SDLSoundDriver::getBufferFill() const
+{
+	return {.filled   = narrow<unsigned>(ring.size()),
+	        .target   = targetFill,
+	        .capacity = narrow<unsigned>(ring.capacity())};
+}
+
+void SDLSoundDriver::setTargetFill(unsigned samples)
+{
+	// Less than one fragment can't work: SDL requests a whole fragment at
+	// once. And keep at least one fragment free for the next upload.
+	targetFill = samples ? std::clamp(samples, fragmentSize, 3 * fragmentSize)
+	                     : 2 * fragmentSize;
+}
+
+unsigned SDLSoundDriver::getUnderrunCount() const
+{
+	return underruns.load(std::memory_order_relaxed);
 }
 
 } // namespace openmsx
@@ -5,10 +5,12 @@
 
 #include "SDLSurfacePtr.hh"
 
-#include "MemBuffer.hh"
+#include "SPSCRingBuffer.hh"
 
 #include <SDL.h>
 
+#include <atomic>
+
 namespace openmsx {
 
 class Reactor;
@@ -31,21 +33,25 @@ public:
 
 	void uploadBuffer(std::span<const StereoFloat> buffer) override;
 
+	[[nodiscard]] BufferFill getBufferFill() const override;
+	void setTargetFill(unsigned samples) override;
+	[[nodiscard]] unsigned getUnderrunCount() const override;
+
 private:
 	void reInit();
-	[[nodiscard]] unsigned getBufferFilled() const;
-	[[nodiscard]] unsigned getBufferFree() const;
 	static void audioCallbackHelper(void* userdata, uint8_t* strm, int len);
 	void audioCallback(std::span<StereoFloat> stream);
 
 private:
 	Reactor& reactor;
 	SDL_AudioDeviceID deviceID;
-	MemBuffer<StereoFloat> mixBuffer;
-	unsigned mixBufferSize;
 	unsigned frequency;
 	unsigned fragmentSize;
-	unsigned readIdx, writeIdx;
+	unsigned targetFill;
+	// Written by the emulation thread, read by the SDL audio thread.
+	// No locking needed on either side, see SPSCRingBuffer.
+	SPSCRingBuffer<StereoFloat> ring;
+	std::atomic<unsigned> underruns = 0;
 	bool muted = true;
 	[[no_unique_address]] SDLSubSystemInitializer<SDL_INIT_AUDIO> audioInitializer;
 };
@@ -31,6 +31,27 @@ public:
 
 	virtual void uploadBuffer(std::span<const StereoFloat> buffer) = 0;
 
+	struct BufferFill {
+		unsigned filled = 0;   // number of samples waiting to be played
+		unsigned target = 0;   // fill level the driver tries to maintain
+		unsigned capacity = 0; // maximum number of samples that can be queued
+	};
+	/** Current fill level of the output buffer (all values in samples).
+	  * Can be used to monitor the latency of the sound output.
+	  */
+	[[nodiscard]] virtual BufferFill getBufferFill() const = 0;
+
+	/** Change the fill level (in samples) the driver tries to maintain.
+	  * The value is clipped to a range the driver can handle. Passing
+	  * zero restores the default level.
+	  */
+	virtual void setTargetFill(unsigned samples) = 0;
+
+	/** Number of times the output device wanted more samples than were
+	  * available (and thus played silence), since the driver was created.
+	  */
+	[[nodiscard]] virtual unsigned getUnderrunCount() const = 0;
+
 protected:
 	SoundDriver() = default;
 };
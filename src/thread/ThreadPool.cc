@@ -0,0 +1,90 @@
+#include "ThreadPool.hh"
+
+#include "xrange.hh"
+
+#include <cassert>
+
+namespace openmsx {
+
+ThreadPool::ThreadPool(unsigned numWorkers)
+{
+	setNumWorkers(numWorkers);
+}
+
+ThreadPool::~ThreadPool()
+{
+	stopWorkers();
+}
+
+void ThreadPool::setNumWorkers(unsigned num)
+{
+	if (num == getNumWorkers()) return;
+	stopWorkers();
+	exitLoop = false;
+	workers.reserve(num);
+	for ([[maybe_unused]] auto i : xrange(num)) {
+		workers.emplace_back([this, b = batch]() { workerLoop(b); });
+	}
+}
+
+void ThreadPool::stopWorkers()
+{
+	{
+		std::scoped_lock lock(mutex);
+		exitLoop = true;
+	}
+	startCond.notify_all();
+	for (auto& t : workers) t.join();
+	workers.clear();
+}
+
+void ThreadPool::run(unsigned numJobs, function_ref<void(unsigned)> job)
+{
+	if (workers.empty() || (numJobs <= 1)) {
+		for (auto i : xrange(numJobs)) job(i);
+		return;
+	}
+
+	{
+		std::scoped_lock lock(mutex);
+		assert(busy == 0);
+		currentJob = job;
+		currentNumJobs = numJobs;
+		nextJob = 0;
+		busy = getNumWorkers();
+		++batch;
+	}
+	startCond.notify_all();
+
+	processJobs();
+
+	std::unique_lock lock(mutex);
+	doneCond.wait(lock, [&]{ return busy == 0; });
+	currentJob.reset();
+}
+
+void ThreadPool::processJobs()
+{
+	for (auto i = nextJob++; i < currentNumJobs; i = nextJob++) {
+		(*currentJob)(i);
+	}
+}
+
+void ThreadPool::workerLoop(unsigned seenBatch)
+{
+	while (true) {
+		{
+			std::unique_lock lock(mutex);
+			startCond.wait(lock, [&]{ return exitLoop || (batch != seenBatch); });
+			if (exitLoop) return;
+			seenBatch = batch;
+		}
+
+		processJobs();
+
+		std::scoped_lock lock(mutex);
+		if (--busy == 0) doneCond.notify_one();
+	}
+}
+
+} // namespace openmsx
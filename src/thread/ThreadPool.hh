@@ -0,0 +1,66 @@
+#ifndef THREADPOOL_HH
+#define THREADPOOL_HH
+
+#include "function_ref.hh"
+
+#include <atomic>
+#include <condition_variable>
+#include <mutex>
+#include <optional>
+#include <thread>
+#include <vector>
+
+namespace openmsx {
+
+/** A small set of worker threads to run a batch of independent jobs in
+  * parallel (fork-join). The calling thread takes part in the work, and
+  * run() only returns once all jobs of the batch have finished.
+  *
+  * Intended for short bursts of work that are repeated often (e.g. once
+  * per frame), so the threads are kept alive between batches.
+  */
+class ThreadPool final
+{
+public:
+	explicit ThreadPool(unsigned numWorkers = 0);
+	~ThreadPool();
+
+	ThreadPool(const ThreadPool&) = delete;
+	ThreadPool(ThreadPool&&) = delete;
+	ThreadPool& operator=(const ThreadPool&) = delete;
+	ThreadPool& operator=(ThreadPool&&) = delete;
+
+	/** Change the number of worker threads (not counting the calling
+	  * thread). Must not be called while a batch is running.
+	  */
+	void setNumWorkers(unsigned num);
+	[[nodiscard]] unsigned getNumWorkers() const { return unsigned(workers.size()); }
+
+	/** Execute 'job(i)' for all 'i' in the range [0, numJobs). The jobs
+	  * may run concurrently and in any order. Blocks until all are done.
+	  */
+	void run(unsigned numJobs, function_ref<void(unsigned)> job);
+
+private:
+	void workerLoop(unsigned seenBatch);
+	void processJobs();
+	void stopWorkers();
+
+private:
+	std::vector<std::thread> workers;
+	std::mutex mutex;
+	std::condition_variable startCond;
+	std::condition_variable doneCond;
+
+	// Current batch, only changed (under 'mutex') while no worker is busy.
+	std::optional<function_ref<void(unsigned)>> currentJob;
+	unsigned currentNumJobs = 0;
+	std::atomic<unsigned> nextJob = 0;
+	unsigned batch = 0;   // incremented for each new batch
+	unsigned busy = 0;    // number of workers still busy with this batch
+	bool exitLoop = false;
+};
+
+} // namespace openmsx
+
+#endif
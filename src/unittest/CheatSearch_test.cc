@@ -0,0 +1,83 @@
+#include "catch.hpp"
+#include "CheatSearch.hh"
+
+#include <array>
+#include <cstdint>
+#include <vector>
+
+using namespace openmsx;
+
+static std::vector<unsigned> addresses(const CheatSearch& search)
+{
+	std::vector<unsigned> result;
+	for (const auto& r : search.getResults(size_t(-1))) result.push_back(r.address);
+	return result;
+}
+
+TEST_CASE("CheatSearch: 8-bit")
+{
+	std::vector<uint8_t> mem(200);
+	for (unsigned i = 0; i < mem.size(); ++i) mem[i] = uint8_t(i);
+
+	CheatSearch search;
+	CHECK(!search.isStarted());
+	search.start(mem, false);
+	CHECK(search.isStarted());
+	CHECK(search.count() == 200);
+
+	SECTION("compare with previous snapshot") {
+		mem[3] += 1;   // increased
+		mem[70] -= 1;  // decreased
+		mem[130] += 5; // increased
+		search.filter(mem, CheatSearch::Op::GT, {});
+		CHECK(addresses(search) == std::vector<unsigned>{3, 130});
+		auto results = search.getResults(1);
+		REQUIRE(results.size() == 1);
+		CHECK(results[0].address == 3);
+		CHECK(results[0].oldValue == 3);
+		CHECK(results[0].newValue == 4);
+
+		search.filter(mem, CheatSearch::Op::EQ, {});
+		CHECK(search.count() == 2);
+		search.filter(mem, CheatSearch::Op::NE, {});
+		CHECK(search.count() == 0);
+	}
+	SECTION("compare with value") {
+		search.filter(mem, CheatSearch::Op::GE, 190);
+		CHECK(search.count() == 10);
+		search.filter(mem, CheatSearch::Op::LT, 192);
+		CHECK(addresses(search) == std::vector<unsigned>{190, 191});
+	}
+	SECTION("update and keep") {
+		mem[5] = 99;
+		search.update(mem);
+		CHECK(search.count() == 200);
+		auto results = search.getResults(10);
+		CHECK(results[5].oldValue == 5);
+		CHECK(results[5].newValue == 99);
+
+		std::array<unsigned, 4> keep = {7, 150, 1000, 64};
+		search.keep(keep);
+		CHECK(addresses(search) == std::vector<unsigned>{7, 64, 150});
+	}
+}
+
+TEST_CASE("CheatSearch: 16-bit")
+{
+	std::vector<uint8_t> mem(100, 0);
+	mem[10] = 0x34; mem[11] = 0x12; // 0x1234 at address 10
+
+	CheatSearch search;
+	search.start(mem, true);
+	CHECK(search.count() == 99); // no value starts at the last address
+
+	search.filter(mem, CheatSearch::Op::EQ, 0x1234);
+	CHECK(addresses(search) == std::vector<unsigned>{10});
+
+	mem[11] = 0x13;
+	search.filter(mem, CheatSearch::Op::GT, {});
+	auto results = search.getResults(10);
+	REQUIRE(results.size() == 1);
+	CHECK(results[0].oldValue == 0x1234);
+	CHECK(results[0].newValue == 0x1334);
+}
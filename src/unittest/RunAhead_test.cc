@@ -0,0 +1,139 @@
+#include "catch.hpp"
+#include "RunAhead.hh"
+
+#include <deque>
+#include <map>
+#include <memory>
+
+using namespace openmsx;
+
+static EmuTime T(uint64_t ticks)
+{
+	return EmuTime::zero() + EmuDuration(ticks);
+}
+
+struct TestEvent
+{
+	TestEvent(uint64_t t, bool input_) : time(T(t)), input(input_) {}
+	[[nodiscard]] EmuTime getTime() const { return time; }
+	void setTime(EmuTime::param t) { time = t; }
+
+	EmuTime time;
+	bool input;
+};
+using Events = std::deque<std::unique_ptr<TestEvent>>;
+
+static Events makeEvents(std::initializer_list<std::pair<uint64_t, bool>> list)
+{
+	Events result;
+	for (auto [t, input] : list) {
+		result.push_back(std::make_unique<TestEvent>(t, input));
+	}
+	return result;
+}
+
+static void checkTimes(const Events& events, std::initializer_list<uint64_t> expected)
+{
+	REQUIRE(events.size() == expected.size());
+	size_t i = 0;
+	for (auto t : expected) {
+		INFO("event " << i);
+		CHECK(events[i]->getTime() == T(t));
+		++i;
+	}
+}
+
+static bool isInput(const TestEvent& e) { return e.input; }
+
+struct FrameChunk
+{
+	EmuTime time;
+	unsigned eventCount;
+};
+
+struct Chunk
+{
+	EmuTime time;
+};
+
+TEST_CASE("RunAhead: earlier")
+{
+	CHECK(RunAhead::earlier(T(1000), EmuDuration(uint64_t(300))) == T(700));
+	CHECK(RunAhead::earlier(T(1000), EmuDuration(uint64_t(1000))) == T(0));
+	CHECK(RunAhead::earlier(T(1000), EmuDuration(uint64_t(5000))) == T(0));
+}
+
+TEST_CASE("RunAhead: selectSnapshot")
+{
+	// one frame snapshot every 100 ticks, 3 events were already recorded
+	// before the first one, the 4th event at time 270
+	std::deque<FrameChunk> frames = {
+		{T(100), 3}, {T(200), 3}, {T(300), 4}, {T(400), 4},
+	};
+	// the newest one that is old enough
+	CHECK(RunAhead::selectSnapshot(frames, 3, T(250)) == 2);
+	CHECK(RunAhead::selectSnapshot(frames, 3, T(200)) == 2);
+	CHECK(RunAhead::selectSnapshot(frames, 3, T(199)) == 1);
+	// none old enough: the oldest one
+	CHECK(RunAhead::selectSnapshot(frames, 3, T(50)) == 1);
+	// snapshots taken after the event was recorded can't be used
+	CHECK(RunAhead::selectSnapshot(frames, 3, T(1000)) == 2);
+	CHECK(RunAhead::selectSnapshot(frames, 4, T(1000)) == 4);
+	// no usable snapshot at all
+	CHECK(RunAhead::selectSnapshot(frames, 2, T(1000)) == 0);
+	CHECK(RunAhead::selectSnapshot(std::deque<FrameChunk>{}, 3, T(1000)) == 0);
+}
+
+TEST_CASE("RunAhead: moveEvents")
+{
+	auto shift = EmuDuration(uint64_t(100));
+
+	SECTION("simple shift") {
+		auto events = makeEvents({{50, true}, {300, true}, {320, true}, {500, true}});
+		RunAhead::moveEvents(events, 1, T(100), shift, isInput);
+		// events before 'first' are never touched
+		checkTimes(events, {50, 200, 220, 400});
+	}
+	SECTION("not before the snapshot") {
+		auto events = makeEvents({{250, true}, {280, true}, {400, true}});
+		RunAhead::moveEvents(events, 0, T(200), shift, isInput);
+		checkTimes(events, {200, 200, 300});
+	}
+	SECTION("not before the preceding (not moved) event") {
+		auto events = makeEvents({{190, true}, {250, true}, {400, true}});
+		RunAhead::moveEvents(events, 1, T(100), shift, isInput);
+		checkTimes(events, {190, 190, 300});
+	}
+	SECTION("commands stay where they are") {
+		auto events = makeEvents({{300, true}, {320, false}, {350, true}, {450, true}});
+		RunAhead::moveEvents(events, 0, T(100), shift, isInput);
+		checkTimes(events, {200, 320, 320, 350});
+	}
+	SECTION("clamped at the start of time") {
+		auto events = makeEvents({{30, true}, {60, true}});
+		RunAhead::moveEvents(events, 0, T(0), shift, isInput);
+		checkTimes(events, {0, 0});
+	}
+	SECTION("nothing to move") {
+		auto events = makeEvents({{30, true}, {60, true}});
+		RunAhead::moveEvents(events, 2, T(0), shift, isInput);
+		checkTimes(events, {30, 60});
+	}
+}
+
+TEST_CASE("RunAhead: eraseNewerSnapshots")
+{
+	std::map<unsigned, Chunk> chunks = {
+		{0, {T(0)}}, {1, {T(100)}}, {2, {T(200)}}, {3, {T(300)}},
+	};
+	RunAhead::eraseNewerSnapshots(chunks, T(300));
+	CHECK(chunks.size() == 4);
+	RunAhead::eraseNewerSnapshots(chunks, T(200));
+	CHECK(chunks.size() == 3);
+	RunAhead::eraseNewerSnapshots(chunks, T(150));
+	REQUIRE(chunks.size() == 2);
+	CHECK(chunks.rbegin()->second.time == T(100));
+	RunAhead::eraseNewerSnapshots(chunks, T(0));
+	REQUIRE(chunks.size() == 1);
+	CHECK(chunks.begin()->first == 0);
+}
@@ -0,0 +1,80 @@
+#include "catch.hpp"
+#include "SPSCRingBuffer.hh"
+
+#include <array>
+#include <thread>
+#include <vector>
+
+using namespace openmsx;
+
+TEST_CASE("SPSCRingBuffer")
+{
+	SPSCRingBuffer<int> buf(4);
+	CHECK(buf.capacity() == 4);
+	CHECK(buf.size() == 0);
+	CHECK(buf.free() == 4);
+
+	std::array<int, 3> in1 = {1, 2, 3};
+	CHECK(buf.write(in1) == 3);
+	CHECK(buf.size() == 3);
+	CHECK(buf.free() == 1);
+
+	std::array<int, 2> out2 = {};
+	CHECK(buf.read(out2) == 2);
+	CHECK(out2 == std::array{1, 2});
+	CHECK(buf.size() == 1);
+
+	// wraps around, only 3 of 4 fit
+	std::array<int, 4> in2 = {4, 5, 6, 7};
+	CHECK(buf.write(in2) == 3);
+	CHECK(buf.size() == 4);
+	CHECK(buf.free() == 0);
+	CHECK(buf.write(in2) == 0);
+
+	// only 4 available
+	std::array<int, 5> out5 = {};
+	CHECK(buf.read(out5) == 4);
+	CHECK(out5 == std::array{3, 4, 5, 6, 0});
+	CHECK(buf.size() == 0);
+	CHECK(buf.read(out5) == 0);
+
+	CHECK(buf.write(in1) == 3);
+	buf.clear();
+	CHECK(buf.size() == 0);
+	CHECK(buf.free() == 4);
+
+	buf.resize(2);
+	CHECK(buf.capacity() == 2);
+	CHECK(buf.write(in1) == 2);
+	CHECK(buf.read(out2) == 2);
+	CHECK(out2 == std::array{1, 2});
+}
+
+TEST_CASE("SPSCRingBuffer: two threads")
+{
+	static constexpr int NUM = 100000;
+	SPSCRingBuffer<int> buf(17);
+
+	std::thread producer([&] {
+		int next = 0;
+		while (next < NUM) {
+			std::array<int, 5> data = {};
+			for (int i = 0; i < 5; ++i) data[i] = next + i;
+			auto len = std::min(5, NUM - next);
+			next += int(buf.write(std::span{data}.first(len)));
+		}
+	});
+
+	std::vector<int> received;
+	while (received.size() < NUM) {
+		std::array<int, 7> data = {};
+		auto num = buf.read(data);
+		received.insert(received.end(), data.begin(), data.begin() + num);
+	}
+	producer.join();
+
+	bool ok = true;
+	for (int i = 0; i < NUM; ++i) ok &= (received[i] == i);
+	CHECK(ok);
+	CHECK(buf.size() == 0);
+}
@@ -0,0 +1,109 @@
+#include "catch.hpp"
+#include "SoundLevelControl.hh"
+
+#include <cmath>
+
+using namespace openmsx;
+
+// Simulate the sound output: the emulation produces samples at (nominal
+// rate * speed factor) and uploads them in blocks, blocking while the buffer
+// would rise above the pacing limit (like SDLSoundDriver::uploadBuffer()).
+// The sound device consumes whole fragments at a rate that slightly differs
+// from the nominal rate (host and sound clock drift). The controller measures
+// the level right after each upload.
+struct Result
+{
+	double avgLevel = 0.0;  // in samples, measured after settling
+	double minSpeed = 2.0;
+	double maxSpeed = 0.0;
+	unsigned blocked = 0;   // number of times pacing blocked, after settling
+	unsigned underruns = 0; // after settling
+};
+
+static Result simulate(unsigned setpoint, double audioRate)
+{
+	static constexpr double FREQ = 44100.0;
+	static constexpr unsigned FRAGMENT = 1024;
+	static constexpr unsigned UPLOAD = 441;
+	static constexpr double STEP = 0.0005;    // in s
+	static constexpr double SETTLE = 40.0;    // in s
+	static constexpr double DURATION = 100.0; // in s
+
+	SoundLevelControl control;
+	auto limit = SoundLevelControl::getPacingLimit(setpoint, FRAGMENT);
+	unsigned level = limit; // as left behind by the pacing alone
+	double produced = 0.0;
+	double lastSync = 0.0;
+	double nextConsume = FRAGMENT / (FREQ * audioRate);
+
+	Result result;
+	double levelSum = 0.0;
+	unsigned levelCount = 0;
+	for (double t = 0.0; t < DURATION; t += STEP) {
+		bool settled = t > SETTLE;
+		while (t >= nextConsume) {
+			if (level >= FRAGMENT) {
+				level -= FRAGMENT;
+			} else {
+				level = 0;
+				if (settled) ++result.underruns;
+			}
+			nextConsume += FRAGMENT / (FREQ * audioRate);
+		}
+		if (produced < UPLOAD) {
+			produced += control.getSpeedFactor() * STEP * FREQ;
+		}
+		if (produced >= UPLOAD) {
+			if ((level + UPLOAD) <= limit) {
+				level += UPLOAD;
+				produced -= UPLOAD;
+				control.update((double(level) - double(setpoint)) / FREQ, t - lastSync);
+				lastSync = t;
+				if (settled) {
+					levelSum += level;
+					++levelCount;
+					result.minSpeed = std::min(result.minSpeed, control.getSpeedFactor());
+					result.maxSpeed = std::max(result.maxSpeed, control.getSpeedFactor());
+				}
+			} else {
+				// emulation is blocked until there's room again
+				if (settled) ++result.blocked;
+			}
+		}
+	}
+	result.avgLevel = levelSum / levelCount;
+	return result;
+}
+
+TEST_CASE("SoundLevelControl: settles below the pacing limit")
+{
+	for (unsigned setpoint : {1024u, 1536u, 2048u}) {
+		for (double audioRate : {1.0, 1.003, 0.997}) {
+			INFO("setpoint=" << setpoint << " audioRate=" << audioRate);
+			auto r = simulate(setpoint, audioRate);
+			// the level is kept at the setpoint ...
+			CHECK(std::abs(r.avgLevel - setpoint) < 128.0);
+			// ... the speed follows the sound clock instead of getting
+			// stuck at one of the extremes ...
+			CHECK(std::abs(r.minSpeed - audioRate) < 0.0005);
+			CHECK(std::abs(r.maxSpeed - audioRate) < 0.0005);
+			// ... so the pacing in the sound driver doesn't kick in anymore
+			CHECK(r.blocked == 0);
+			CHECK(r.underruns == 0);
+		}
+	}
+}
+
+TEST_CASE("SoundLevelControl: correction is limited")
+{
+	SoundLevelControl control;
+	CHECK(control.getSpeedFactor() == 1.0);
+	for (int i = 0; i < 1000; ++i) control.update(1.0, 0.01); // way too full
+	CHECK(control.getSpeedFactor() == 1.0 - SoundLevelControl::MAX_CORRECTION);
+	// the integral doesn't wind up beyond what's needed for the maximum
+	// correction, so it recovers quickly
+	for (int i = 0; i < 100; ++i) control.update(-1.0, 0.01); // way too empty
+	CHECK(control.getSpeedFactor() == 1.0 + SoundLevelControl::MAX_CORRECTION);
+	control.reset();
+	CHECK(control.getSpeedFactor() == 1.0);
+}
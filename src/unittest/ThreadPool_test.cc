@@ -0,0 +1,32 @@
+#include "catch.hpp"
+#include "ThreadPool.hh"
+
+#include "xrange.hh"
+
+#include <atomic>
+#include <vector>
+
+using namespace openmsx;
+
+TEST_CASE("ThreadPool")
+{
+	auto check = [](ThreadPool& pool, unsigned numJobs) {
+		std::vector<std::atomic<int>> counts(numJobs);
+		pool.run(numJobs, [&](unsigned i) { ++counts[i]; });
+		for (const auto& c : counts) CHECK(c == 1);
+	};
+
+	ThreadPool pool;
+	CHECK(pool.getNumWorkers() == 0);
+	check(pool, 0);
+	check(pool, 5);
+
+	pool.setNumWorkers(3);
+	CHECK(pool.getNumWorkers() == 3);
+	for (auto n : xrange(100u)) check(pool, n);
+
+	pool.setNumWorkers(1);
+	CHECK(pool.getNumWorkers() == 1);
+	check(pool, 1);
+	check(pool, 40);
+}
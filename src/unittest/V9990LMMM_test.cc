@@ -0,0 +1,156 @@
+#include "catch.hpp"
+#include "V9990LMMM.hh"
+
+#include "xrange.hh"
+
+#include <array>
+#include <vector>
+
+using namespace openmsx;
+
+// Run the generic LMMM loop and the IMP/TIMP specialized loop on the same
+// VRAM content and registers and check that they give the same result,
+// also when the command is interrupted at arbitrary points (partial rows).
+
+struct TestVRAM
+{
+	TestVRAM()
+	{
+		// pseudo random content, with plenty of zero (transparent) pixels
+		unsigned seed = 4321;
+		for (auto& d : data) {
+			seed = seed * 1103515245 + 12345;
+			auto r = byte(seed >> 16);
+			d = (r & 3) ? r : 0;
+		}
+	}
+	[[nodiscard]] byte readVRAMDirect(unsigned address) const {
+		return data[address];
+	}
+	void writeVRAMDirect(unsigned address, byte value) {
+		data[address] = value;
+	}
+	std::vector<byte> data = std::vector<byte>(V9990VRAM::VRAM_SIZE);
+};
+
+struct Setup
+{
+	word SX, SY, DX, DY, NX, NY, WM;
+	byte ARG;
+};
+
+static constexpr byte DIY = 0x08;
+static constexpr byte DIX = 0x04;
+
+static V9990LMMM::Regs makeRegs(const Setup& s, byte op)
+{
+	word wrappedNX = s.NX ? s.NX : 2048;
+	return {
+		.SX = s.SX, .SY = s.SY, .DX = s.DX, .DY = s.DY,
+		.ANX = wrappedNX, .ANY = s.NY,
+		.NX = s.NX, .wrappedNX = wrappedNX,
+		.WM = s.WM,
+		.dx = (s.ARG & DIX) ? word(-1) : word(1),
+		.dy = (s.ARG & DIY) ? word(-1) : word(1),
+		.LOG = op,
+	};
+}
+
+static void checkSameRegs(const V9990LMMM::Regs& r1, const V9990LMMM::Regs& r2)
+{
+	REQUIRE(r1.SX  == r2.SX);
+	REQUIRE(r1.SY  == r2.SY);
+	REQUIRE(r1.DX  == r2.DX);
+	REQUIRE(r1.DY  == r2.DY);
+	REQUIRE(r1.ANX == r2.ANX);
+	REQUIRE(r1.ANY == r2.ANY);
+}
+
+template<typename Mode>
+static void test(unsigned width, const Setup& setup, byte op, unsigned delta, unsigned step)
+{
+	INFO("bpp=" << Mode::BITS_PER_PIXEL << " op=" << int(op) <<
+	     " SX=" << setup.SX << " SY=" << setup.SY <<
+	     " DX=" << setup.DX << " DY=" << setup.DY <<
+	     " NX=" << setup.NX << " NY=" << setup.NY <<
+	     " WM=" << setup.WM << " ARG=" << int(setup.ARG) <<
+	     " delta=" << delta << " step=" << step);
+	REQUIRE(V9990LogOp::isImp(op));
+	unsigned pitch = Mode::getPitch(width);
+
+	TestVRAM vram1, vram2;
+	auto r1 = makeRegs(setup, op);
+	auto r2 = r1;
+	auto time1 = EmuTime::zero();
+	auto time2 = EmuTime::zero();
+	auto limit = EmuTime::zero();
+	auto dur = EmuDuration(uint64_t(delta));
+
+	bool ready1 = false;
+	bool ready2 = false;
+	while (!ready1 && !ready2) {
+		limit += EmuDuration(uint64_t(step));
+		ready1 = V9990LMMM::execute   <Mode>(vram1, r1, pitch, dur, time1, limit);
+		ready2 = V9990LMMM::executeImp<Mode>(vram2, r2, pitch, dur, time2, limit);
+		REQUIRE(ready1 == ready2);
+		REQUIRE(time1 == time2);
+		checkSameRegs(r1, r2);
+		bool sameVRAM = vram1.data == vram2.data;
+		REQUIRE(sameVRAM);
+	}
+	CHECK(ready1);
+	CHECK(ready2);
+	if (setup.WM != 0) {
+		// make sure the test actually did something
+		bool changed = vram1.data != TestVRAM().data;
+		CHECK(changed);
+	}
+}
+
+template<typename Mode>
+static void testAll(unsigned width)
+{
+	static constexpr std::array setups = {
+		// plain copy
+		Setup{  10,  20, 100, 200,   37,  9, 0xFFFF, 0},
+		// DIX, DIY and both
+		Setup{ 200,  50,  60, 300,   45,  7, 0xFFFF, DIX},
+		Setup{  20, 150, 260,  40,   33,  6, 0xFFFF, DIY},
+		Setup{ 300, 310,  80,  90,   29,  5, 0xFFFF, DIX | DIY},
+		// overlapping source and destination
+		Setup{  40,  40,  43,  41,   64, 10, 0xFFFF, 0},
+		Setup{  43,  41,  40,  40,   64, 10, 0xFFFF, DIX | DIY},
+		// horizontal wrap within a line
+		Setup{ 240,  12, 250,  30,   40,  4, 0xFFFF, 0},
+		Setup{   5,  12,   3,  30,   40,  4, 0xFFFF, DIX},
+		// vertical wrap at the end (and start) of VRAM
+		Setup{  50, 4093,  60, 4094,  20,  6, 0xFFFF, 0},
+		Setup{  50,    2,  60,    1,  20,  6, 0xFFFF, DIY},
+		// write masks
+		Setup{  10,  20, 100, 200,   37,  9, 0x00FF, 0},
+		Setup{  10,  20, 100, 200,   37,  9, 0xF00F, DIX},
+		Setup{  10,  20, 100, 200,   37,  9, 0x0000, 0},
+		// NX=0 means 2048 pixels
+		Setup{   0,   0,   0, 100,    0,  2, 0xFFFF, 0},
+	};
+	for (const auto& setup : setups) {
+		for (byte op : {byte(0x0C), byte(0x1C)}) { // IMP and TIMP
+			test<Mode>(width, setup, op, 7, 1000000); // complete in one go
+			test<Mode>(width, setup, op, 7, 53);      // partial rows
+			test<Mode>(width, setup, op, 7, 5);       // less than a pixel
+			test<Mode>(width, setup, op, 0, 1);       // broken cmd timing
+		}
+	}
+}
+
+TEST_CASE("V9990LMMM: IMP/TIMP fast path, 8bpp")
+{
+	testAll<V9990LMMM::Bpp8<TestVRAM>>(256);
+	testAll<V9990LMMM::Bpp8<TestVRAM>>(512);
+}
+
+TEST_CASE("V9990LMMM: IMP/TIMP fast path, 16bpp")
+{
+	testAll<V9990LMMM::Bpp16<TestVRAM>>(256);
+	testAll<V9990LMMM::Bpp16<TestVRAM>>(512);
+}
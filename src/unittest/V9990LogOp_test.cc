@@ -0,0 +1,67 @@
+#include "catch.hpp"
+#include "V9990LogOp.hh"
+
+#include "xrange.hh"
+
+#include <array>
+
+using namespace openmsx;
+using namespace openmsx::V9990LogOp;
+
+// The LMMM fast path (imp8/imp16) must give the same result as the generic
+// LUT based path, but only for the logical operations where executeLMMM()
+// selects it (isImp()). For all other operations the results must differ
+// for at least some input, otherwise this test would prove nothing.
+
+TEST_CASE("V9990LogOp: 8bpp fast path")
+{
+	static constexpr std::array<byte, 5> masks = {0xFF, 0x00, 0x0F, 0xA5, 0x80};
+	for (auto op : xrange(0x20u)) {
+		bool transp = (op & 0x10) != 0;
+		auto lut = getLUT(transp ? Mode::BPP8 : Mode::NO_T, op);
+		bool allSame = true;
+		for (auto mask : masks) {
+			for (auto src : xrange(256)) {
+				for (auto dst : xrange(256)) {
+					auto generic = apply8(lut, byte(src), byte(dst), mask);
+					// executeLMMMImp() passes 0 for 'dst' when all bits get overwritten
+					auto fastDst = (mask == 0xFF) ? byte(0) : byte(dst);
+					auto fast = imp8(byte(src), fastDst, mask, transp).value_or(byte(dst));
+					allSame &= (fast == generic);
+				}
+			}
+		}
+		INFO("op = " << op);
+		CHECK(allSame == isImp(op));
+	}
+}
+
+TEST_CASE("V9990LogOp: 16bpp fast path")
+{
+	static constexpr std::array<word, 5> masks = {0xFFFF, 0x0000, 0x00FF, 0xF00F, 0x8000};
+	// a few edge cases followed by pseudo random values
+	std::array<word, 64> values = {0x0000, 0x0001, 0x0100, 0x00FF, 0xFF00, 0xFFFF};
+	unsigned seed = 12345;
+	for (auto i : xrange(6u, unsigned(values.size()))) {
+		seed = seed * 1103515245 + 12345;
+		values[i] = word(seed >> 12);
+	}
+
+	for (auto op : xrange(0x20u)) {
+		bool transp = (op & 0x10) != 0;
+		auto lut = getLUT(Mode::NO_T, op);
+		bool allSame = true;
+		for (auto mask : masks) {
+			for (auto src : values) {
+				for (auto dst : values) {
+					auto generic = apply16(lut, src, dst, mask, transp);
+					auto fastDst = (mask == 0xFFFF) ? word(0) : dst;
+					auto fast = imp16(src, fastDst, mask, transp).value_or(dst);
+					allSame &= (fast == generic);
+				}
+			}
+		}
+		INFO("op = " << op);
+		CHECK(allSame == isImp(op));
+	}
+}
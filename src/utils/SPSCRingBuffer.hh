@@ -0,0 +1,105 @@
+#ifndef SPSCRINGBUFFER_HH
+#define SPSCRINGBUFFER_HH
+
+#include <algorithm>
+#include <atomic>
+#include <cassert>
+#include <cstddef>
+#include <span>
+#include <type_traits>
+#include <vector>
+
+namespace openmsx {
+
+/** Wait-free ring buffer for one producer and one consumer thread.
+  *
+  * One thread only calls write(), another thread only calls read(). Neither
+  * of them ever blocks: write() stores as much as fits, read() takes as much
+  * as is available. size() and free() may be called from both threads (and
+  * from other threads) to monitor the fill level, though the result may
+  * already be outdated when it's used.
+  *
+  * clear() and resize() are not thread-safe, only call them while no other
+  * thread is accessing the buffer.
+  */
+template<typename T>
+class SPSCRingBuffer
+{
+	static_assert(std::is_trivially_copyable_v<T>);
+
+public:
+	explicit SPSCRingBuffer(size_t capacity = 0)
+		: buffer(capacity + 1) // one slot stays unused to distinguish full from empty
+	{
+	}
+
+	[[nodiscard]] size_t capacity() const { return buffer.size() - 1; }
+
+	/** Number of elements that can be read. */
+	[[nodiscard]] size_t size() const {
+		auto w = writeIdx.load(std::memory_order_acquire);
+		auto r = readIdx .load(std::memory_order_acquire);
+		return distance(r, w);
+	}
+	/** Number of elements that can be written. */
+	[[nodiscard]] size_t free() const { return capacity() - size(); }
+
+	/** Producer: append (a prefix of) 'data'. Returns the number of
+	  * elements that were written, this is less than 'data.size()' when
+	  * the buffer is (almost) full. */
+	size_t write(std::span<const T> data) {
+		auto w = writeIdx.load(std::memory_order_relaxed);
+		auto r = readIdx .load(std::memory_order_acquire);
+		auto num = std::min(data.size(), capacity() - distance(r, w));
+		auto num1 = std::min(num, buffer.size() - w);
+		std::copy_n(data.data(), num1, &buffer[w]);
+		std::copy_n(data.data() + num1, num - num1, buffer.data());
+		writeIdx.store(wrap(w + num), std::memory_order_release);
+		return num;
+	}
+
+	/** Consumer: fill (a prefix of) 'out'. Returns the number of
+	  * elements that were read, this is less than 'out.size()' when
+	  * the buffer runs empty. */
+	size_t read(std::span<T> out) {
+		auto r = readIdx .load(std::memory_order_relaxed);
+		auto w = writeIdx.load(std::memory_order_acquire);
+		auto num = std::min(out.size(), distance(r, w));
+		auto num1 = std::min(num, buffer.size() - r);
+		std::copy_n(&buffer[r], num1, out.data());
+		std::copy_n(buffer.data(), num - num1, out.data() + num1);
+		readIdx.store(wrap(r + num), std::memory_order_release);
+		return num;
+	}
+
+	void clear() {
+		readIdx .store(0, std::memory_order_relaxed);
+		writeIdx.store(0, std::memory_order_relaxed);
+	}
+
+	/** Change the capacity, this also discards the content. */
+	void resize(size_t capacity) {
+		buffer.assign(capacity + 1, T{});
+		clear();
+	}
+
+private:
+	[[nodiscard]] size_t distance(size_t from, size_t to) const {
+		return (to >= from) ? (to - from) : (to + buffer.size() - from);
+	}
+	[[nodiscard]] size_t wrap(size_t idx) const {
+		assert(idx < 2 * buffer.size());
+		return (idx >= buffer.size()) ? (idx - buffer.size()) : idx;
+	}
+
+private:
+	std::vector<T> buffer;
+	// On separate cache lines, so that the producer and the consumer
+	// don't keep stealing the same line from each other.
+	alignas(64) std::atomic<size_t> readIdx = 0;
+	alignas(64) std::atomic<size_t> writeIdx = 0;
+};
+
+} // namespace openmsx
+
+#endif
@@ -96,11 +96,8 @@ void OutputBuffer::insertGrow(const void* __restrict data, size_t len)
 
 InputBuffer::InputBuffer(const uint8_t* data, size_t size)
 	: buf(data)
-#ifndef NDEBUG
 	, finish(buf + size)
-#endif
 {
-	(void)size;
 }
 
 } // namespace openmsx
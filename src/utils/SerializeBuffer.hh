@@ -208,11 +208,15 @@ public:
 	  */
 	[[nodiscard]] const uint8_t* getCurrentPos() const { return buf; }
 
+	/** The number of bytes that are not yet consumed.
+	  * read() and skip() only assert on buffer overruns, use this to
+	  * validate untrusted input before reading it.
+	  */
+	[[nodiscard]] size_t remaining() const { return finish - buf; }
+
 private:
 	const uint8_t* buf;
-#ifndef NDEBUG
-	const uint8_t* finish; // only used to check asserts
-#endif
+	const uint8_t* finish;
 };
 
 } // namespace openmsx
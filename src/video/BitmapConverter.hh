@@ -81,6 +81,15 @@ public:
 		dPaletteValid = false;
 	}
 
+	/** Normally the palette derived from palette16 is recalculated lazily
+	  * during the first conversion. Call this to do it up front, so that
+	  * convertLine() can afterwards be used from multiple threads.
+	  */
+	inline void updateDPalette()
+	{
+		if (!dPaletteValid) calcDPalette();
+	}
+
 private:
 	void calcDPalette();
 
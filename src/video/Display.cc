@@ -17,6 +17,7 @@
 #include "CliComm.hh"
 #include "Timer.hh"
 #include "IntegerSetting.hh"
+#include "LatencyController.hh"
 #include "EnumSetting.hh"
 #include "Reactor.hh"
 #include "MSXMotherBoard.hh"
@@ -333,6 +334,7 @@ void Display::repaintImpl()
 
 	cancelRT(); // cancel delayed repaint
 
+	auto start = Timer::getTime();
 	if (!renderFrozen) {
 		assert(videoSystem);
 		if (OutputSurface* surface = videoSystem->getOutputSurface()) {
@@ -347,6 +349,7 @@ void Display::repaintImpl()
 	prevTimeStamp = now;
 	frameDurationSum += duration - frameDurations.removeBack();
 	frameDurations.addFront(duration);
+	reactor.getLatencyController().framePresented(now - start, now);
 
 	// TODO maybe revisit this later (and/or simplify other calls to repaintDelayed())
 	// This ensures a minimum framerate for ImGui
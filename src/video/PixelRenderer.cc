@@ -29,11 +29,13 @@ TODO:
 #include <algorithm>
 #include <cassert>
 #include <cmath>
+#include <thread>
 
 namespace openmsx {
 
 void PixelRenderer::draw(
-	int startX, int startY, int endX, int endY, DrawType drawType, bool atEnd)
+	int startX, int startY, int endX, int endY, DrawType drawType,
+	bool atEnd, int& textCounter)
 {
 	if (drawType == DRAW_BORDER) {
 		rasterizer->drawBorder(startX, startY, endX, endY);
@@ -49,11 +51,11 @@ void PixelRenderer::draw(
 		} else {
 			// this is not what the real VDP does, but it is good
 			// enough for "Boring scroll" demo part of "Relax"
-			displayY = (displayY & 7) | (textModeCounter * 8);
+			displayY = (displayY & 7) | (textCounter * 8);
 			if (atEnd && (drawType == DRAW_DISPLAY)) {
 				int low  = std::max(0, (startY - zero)) / 8;
 				int high = std::max(0, (endY   - zero)) / 8;
-				textModeCounter += (high - low);
+				textCounter += (high - low);
 			}
 		}
 
@@ -80,14 +82,14 @@ void PixelRenderer::draw(
 
 void PixelRenderer::subdivide(
 	int startX, int startY, int endX, int endY, int clipL, int clipR,
-	DrawType drawType)
+	DrawType drawType, int& textCounter)
 {
 	// Partial first line.
 	if (startX > clipL) {
 		bool atEnd = (startY != endY) || (endX >= clipR);
 		if (startX < clipR) {
 			draw(startX, startY, (atEnd ? clipR : endX),
-			     startY + 1, drawType, atEnd);
+			     startY + 1, drawType, atEnd, textCounter);
 		}
 		if (startY == endY) return;
 		startY++;
@@ -101,13 +103,78 @@ void PixelRenderer::subdivide(
 	}
 	// Full middle lines.
 	if (startY < endY) {
-		draw(clipL, startY, clipR, endY, drawType, true);
+		draw(clipL, startY, clipR, endY, drawType, true, textCounter);
 	}
 	// Actually draw last line if necessary.
 	// The point of keeping top-to-bottom draw order is that it increases
 	// the locality of memory references, which generally improves cache
 	// hit rates.
-	if (drawLast) draw(clipL, endY, endX, endY + 1, drawType, false);
+	if (drawLast) draw(clipL, endY, endX, endY + 1, drawType, false, textCounter);
+}
+
+void PixelRenderer::renderLines(
+	int startX, int startY, int endX, int endY, int& textCounter)
+{
+	if (displayEnabled) {
+		// Calculate start and end of borders in ticks since start of line.
+		// The 0..7 extra horizontal scroll low pixels should be drawn in
+		// border color. These will be drawn together with the border,
+		// but sprites above these pixels are clipped at the actual border
+		// rather than the end of the border colored area.
+		// TODO: Move these calculations and getDisplayLeft() to VDP.
+		int borderL = vdp.getLeftBorder();
+		int displayL =
+			vdp.isBorderMasked() ? borderL : vdp.getLeftBackground();
+		int borderR = vdp.getRightBorder();
+
+		// It's important that right border is drawn last (after left
+		// border and display area). See comment in SDLRasterizer::drawBorder().
+		// Left border.
+		subdivide(startX, startY, endX, endY,
+			0, displayL, DRAW_BORDER, textCounter);
+		// Display area.
+		subdivide(startX, startY, endX, endY,
+			displayL, borderR, DRAW_DISPLAY, textCounter);
+		// Right border.
+		subdivide(startX, startY, endX, endY,
+			borderR, VDP::TICKS_PER_LINE, DRAW_BORDER, textCounter);
+	} else {
+		subdivide(startX, startY, endX, endY,
+			0, VDP::TICKS_PER_LINE, DRAW_BORDER, textCounter);
+	}
+}
+
+void PixelRenderer::renderLinesConcurrent(int startY, int endY)
+{
+	// Several bands per thread, so that a thread that got a cheap band
+	// (e.g. only border) can pick up another one.
+	unsigned numThreads = renderThreads.getNumWorkers() + 1;
+	unsigned numBands = std::min(4 * numThreads,
+	                             unsigned(endY - startY) / MIN_BAND_LINES);
+	auto bandStart = [&](unsigned band) {
+		return startY + narrow<int>((endY - startY) * band / numBands);
+	};
+
+	// Only the display area in text modes advances the text mode counter.
+	// That happens once per 8 lines, so the start value for each band can
+	// be calculated up front.
+	bool textMode = displayEnabled && vdp.getDisplayMode().isTextMode();
+	int zero = vdp.getLineZero();
+	auto textCounterAt = [&](int y) {
+		if (!textMode) return textModeCounter;
+		return textModeCounter + std::max(0, y - zero) / 8
+		                       - std::max(0, startY - zero) / 8;
+	};
+
+	rasterizer->prepareConcurrentDraw();
+	renderThreads.run(numBands, [&](unsigned band) {
+		int y0 = bandStart(band);
+		int y1 = bandStart(band + 1);
+		int textCounter = textCounterAt(y0);
+		renderLines(0, y0, 0, y1, textCounter);
+		assert(textCounter == textCounterAt(y1));
+	});
+	textModeCounter = textCounterAt(endY);
 }
 
 PixelRenderer::PixelRenderer(VDP& vdp_, Display& display)
@@ -577,43 +644,44 @@ void PixelRenderer::renderUntil(EmuTime::param time)
 	// Also it is a small performance optimisation.
 	if (limitX == nextX && limitY == nextY) return;
 
-	if (displayEnabled) {
-		if (vdp.spritesEnabled()) {
-			// Update sprite checking, so that rasterizer can call getSprites.
-			spriteChecker.checkUntil(time);
-		}
-
-		// Calculate start and end of borders in ticks since start of line.
-		// The 0..7 extra horizontal scroll low pixels should be drawn in
-		// border color. These will be drawn together with the border,
-		// but sprites above these pixels are clipped at the actual border
-		// rather than the end of the border colored area.
-		// TODO: Move these calculations and getDisplayLeft() to VDP.
-		int borderL = vdp.getLeftBorder();
-		int displayL =
-			vdp.isBorderMasked() ? borderL : vdp.getLeftBackground();
-		int borderR = vdp.getRightBorder();
+	if (displayEnabled && vdp.spritesEnabled()) {
+		// Update sprite checking, so that rasterizer can call getSprites.
+		spriteChecker.checkUntil(time);
+	}
 
-		// It's important that right border is drawn last (after left
-		// border and display area). See comment in SDLRasterizer::drawBorder().
-		// Left border.
-		subdivide(nextX, nextY, limitX, limitY,
-			0, displayL, DRAW_BORDER);
-		// Display area.
-		subdivide(nextX, nextY, limitX, limitY,
-			displayL, borderR, DRAW_DISPLAY);
-		// Right border.
-		subdivide(nextX, nextY, limitX, limitY,
-			borderR, VDP::TICKS_PER_LINE, DRAW_BORDER);
+	// Typically at the end of the frame (or always with 'screen' accuracy)
+	// a large block of complete lines remains to be drawn. Those lines
+	// don't depend on each other, so split them in bands and render those
+	// in parallel. Any partial first and last lines are drawn as usual.
+	int fullStartY = nextY + (nextX != 0);
+	if (((limitY - fullStartY) >= MIN_CONCURRENT_LINES) && updateRenderThreads()) {
+		if (nextX != 0) {
+			renderLines(nextX, nextY, 0, fullStartY, textModeCounter);
+		}
+		renderLinesConcurrent(fullStartY, limitY);
+		if (limitX != 0) {
+			renderLines(0, limitY, limitX, limitY, textModeCounter);
+		}
 	} else {
-		subdivide(nextX, nextY, limitX, limitY,
-			0, VDP::TICKS_PER_LINE, DRAW_BORDER);
+		renderLines(nextX, nextY, limitX, limitY, textModeCounter);
 	}
 
 	nextX = limitX;
 	nextY = limitY;
 }
 
+bool PixelRenderer::updateRenderThreads()
+{
+	auto numThreads = [&]() -> unsigned {
+		if (int n = renderSettings.getRenderThreads()) return unsigned(n);
+		// Beyond a few threads the synchronization overhead outweighs
+		// the gain for the ~240 lines of a frame.
+		return std::clamp(std::thread::hardware_concurrency(), 1u, 4u);
+	}();
+	renderThreads.setNumWorkers(numThreads - 1);
+	return numThreads > 1;
+}
+
 void PixelRenderer::update(const Setting& setting) noexcept
 {
 	assert(&setting == one_of(&renderSettings.getMinFrameSkipSetting(),
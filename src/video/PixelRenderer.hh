@@ -4,6 +4,7 @@
 #include "Renderer.hh"
 #include "Observer.hh"
 #include "RenderSettings.hh"
+#include "ThreadPool.hh"
 #include "openmsx.hh"
 #include <cstdint>
 #include <memory>
@@ -67,12 +68,20 @@ private:
 	// Observer<Setting> interface:
 	void update(const Setting& setting) noexcept override;
 
+	/** Only use multiple threads when at least this many complete lines
+	  * need to be drawn, and give each thread at least this many lines.
+	  */
+	static constexpr int MIN_CONCURRENT_LINES = 64;
+	static constexpr unsigned MIN_BAND_LINES = 8;
+
 	/** Call the right draw method in the subclass,
 	  * depending on passed drawType.
+	  * @param textCounter The text mode counter to use (and update),
+	  *     see 'textModeCounter'.
 	  */
 	void draw(
 		int startX, int startY, int endX, int endY, DrawType drawType,
-		bool atEnd);
+		bool atEnd, int& textCounter);
 
 	/** Subdivide an area specified by two scan positions into a series of
 	  * rectangles.
@@ -83,7 +92,22 @@ private:
 	  */
 	void subdivide(
 		int startX, int startY, int endX, int endY,
-		int clipL, int clipR, DrawType drawType);
+		int clipL, int clipR, DrawType drawType, int& textCounter);
+
+	/** Draw the border and display area between two scan positions.
+	  */
+	void renderLines(
+		int startX, int startY, int endX, int endY, int& textCounter);
+
+	/** Draw the complete lines [startY, endY), split in bands which are
+	  * drawn in parallel on the render threads.
+	  */
+	void renderLinesConcurrent(int startY, int endY);
+
+	/** Adjust the number of render threads to the 'render_threads'
+	  * setting. Returns true when more than one thread is used.
+	  */
+	bool updateRenderThreads();
 
 	[[nodiscard]] bool checkSync(unsigned offset, EmuTime::param time) const;
 
@@ -124,6 +148,11 @@ private:
 
 	const std::unique_ptr<Rasterizer> rasterizer;
 
+	/** Helper threads to render many lines at once, see
+	  * renderLinesConcurrent().
+	  */
+	ThreadPool renderThreads;
+
 	float finishFrameDuration = 0.0f;
 	float frameSkipCounter = 999.0f; // force drawing of frame
 
@@ -100,6 +100,15 @@ public:
 		int displayX, int displayY,
 		int displayWidth, int displayHeight) = 0;
 
+	/** Prepare for a series of drawBorder(), drawDisplay() and
+	  * drawSprites() calls that run concurrently on multiple threads.
+	  * Those concurrent calls never write to the same line, and the VDP
+	  * state remains unchanged until they have all finished. Any state
+	  * that is normally (re)calculated lazily during drawing must be
+	  * brought up to date here.
+	  */
+	virtual void prepareConcurrentDraw() = 0;
+
 	/** Is video recording active?
 	  */
 	[[nodiscard]] virtual bool isRecording() const = 0;
@@ -55,6 +55,10 @@ RenderSettings::RenderSettings(CommandController& commandController)
 	, minFrameSkipSetting(commandController,
 		"minframeskip", "set the min amount of frameskip", 0, 0, 100)
 
+	, renderThreadsSetting(commandController,
+		"render_threads", "number of threads used to render the scanlines "
+		"of a frame, 0 means automatic", 0, 0, 16)
+
 	, fullScreenSetting(commandController,
 		"fullscreen", "full screen display on/off", false)
 
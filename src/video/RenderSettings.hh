@@ -65,6 +65,9 @@ public:
 	[[nodiscard]] IntegerSetting& getMinFrameSkipSetting() { return minFrameSkipSetting; }
 	[[nodiscard]] int getMinFrameSkip() const { return minFrameSkipSetting.getInt(); }
 
+	/** Number of threads for rendering scanlines, 0 means automatic. */
+	[[nodiscard]] int getRenderThreads() const { return renderThreadsSetting.getInt(); }
+
 	/** Full screen [on, off]. */
 	[[nodiscard]] BooleanSetting& getFullScreenSetting() { return fullScreenSetting; }
 	[[nodiscard]] bool getFullScreen() const { return fullScreenSetting.getBoolean(); }
@@ -214,6 +217,7 @@ private:
 	BooleanSetting deflickerSetting;
 	IntegerSetting maxFrameSkipSetting;
 	IntegerSetting minFrameSkipSetting;
+	IntegerSetting renderThreadsSetting;
 	BooleanSetting fullScreenSetting;
 	FloatSetting gammaSetting;
 	FloatSetting brightnessSetting;
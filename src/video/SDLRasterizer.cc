@@ -598,6 +598,11 @@ void SDLRasterizer::drawSprites(
 	}
 }
 
+void SDLRasterizer::prepareConcurrentDraw()
+{
+	bitmapConverter.updateDPalette();
+}
+
 bool SDLRasterizer::isRecording() const
 {
 	return postProcessor->isRecording();
@@ -63,6 +63,7 @@ public:
 		int fromX, int fromY,
 		int displayX, int displayY,
 		int displayWidth, int displayHeight) override;
+	void prepareConcurrentDraw() override;
 	[[nodiscard]] bool isRecording() const override;
 
 private:
@@ -87,6 +87,16 @@ void VDPVRAM::PhysicalVRAMDebuggable::write(
 	vram.cpuWrite(address, value, time);
 }
 
+void VDPVRAM::PhysicalVRAMDebuggable::readBlock(unsigned address, std::span<byte> output)
+{
+	// Sync once with the command engine (instead of per byte, as in
+	// cpuRead()) and then copy the whole block at once.
+	auto& vram = OUTER(VDPVRAM, physicalVRAMDebug);
+	assert((address + output.size()) <= vram.actualSize);
+	vram.cmdEngine->sync(getMotherBoard().getCurrentTime());
+	ranges::copy(std::span{&vram.data[address], output.size()}, output);
+}
+
 
 // class VDPVRAM
 
@@ -650,6 +650,7 @@ private:
 		PhysicalVRAMDebuggable(const VDP& vdp, unsigned actualSize);
 		[[nodiscard]] byte read(unsigned address, EmuTime::param time) override;
 		void write(unsigned address, byte value, EmuTime::param time) override;
+		void readBlock(unsigned address, std::span<byte> output) override;
 	} physicalVRAMDebug;
 
 	// TODO: Renderer field can be removed, if updateDisplayMode
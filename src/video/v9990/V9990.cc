@@ -592,6 +592,7 @@ void V9990::writeRegister(byte reg, byte val, EmuTime::param time)
 	}
 
 	val &= regWriteMask[reg];
+	++registerChangeCount;
 
 	// This optimization is not valid for the vertical scroll registers
 	// TODO is this optimization still useful for other registers?
@@ -701,6 +702,11 @@ void V9990::createRenderer(EmuTime::param time)
 void V9990::frameStart(EmuTime::param time)
 {
 	// Update setings that are fixed at the start of a frame
+	if ((interlaced   != ((regs[SCREEN_MODE_1] & 0x02) != 0)) ||
+	    (scrollAYHigh != regs[SCROLL_CONTROL_AY1]) ||
+	    (scrollBYHigh != regs[SCROLL_CONTROL_BY1])) {
+		++registerChangeCount;
+	}
 	displayEnabled = (regs[CONTROL]       & 0x80) != 0;
 	palTiming      = (regs[SCREEN_MODE_1] & 0x08) != 0;
 	interlaced     = (regs[SCREEN_MODE_1] & 0x02) != 0;
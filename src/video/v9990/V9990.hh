@@ -19,6 +19,7 @@
 #include "serialize_meta.hh"
 #include "unreachable.hh"
 #include <array>
+#include <cstdint>
 #include <memory>
 #include <optional>
 
@@ -77,6 +78,15 @@ public:
 		return (status & 0x02) != 0;
 	}
 
+	/** Counter that is incremented on every (non-command) register write
+	  * and when one of the values that are latched at the start of a frame
+	  * changes. Together with V9990VRAM::getWriteCount() this allows the
+	  * renderer to detect that a display line will render identically.
+	  */
+	[[nodiscard]] uint64_t getRegisterChangeCount() const {
+		return registerChangeCount;
+	}
+
 	/** Is the display enabled?
 	  *  Note this is simpler than the V99x8 version. Probably ok
 	  *  because V9990 doesn't have the same overscan trick (?)
@@ -581,6 +591,11 @@ private:
 	std::array<byte, 0x40> regs = {}; // fill with zero
 	byte regSelect;
 
+	/** See getRegisterChangeCount(). Not serialized, the renderer is
+	  * reset after loading a savestate anyway.
+	  */
+	uint64_t registerChangeCount = 0;
+
 	/** Is PAL timing active?  False means NTSC timing
 	  */
 	bool palTiming{false};
@@ -609,8 +624,8 @@ private:
 	  *       as on V99x8, see V9990PixelRenderer::updateScrollAYLow() for
 	  *       details.
 	  */
-	byte scrollAYHigh;
-	byte scrollBYHigh;
+	byte scrollAYHigh = 0;
+	byte scrollBYHigh = 0;
 
 	/** Corresponds to bit 1 in the System Control Port.
 	  * When this is true, all registers are held in the 'power ON reset'
@@ -509,4 +509,21 @@ void V9990BitmapConverter::convertLine(
 	}
 }
 
+uint64_t V9990BitmapConverter::getVRAMWriteCount(
+	unsigned x, unsigned y, unsigned width, bool drawCursors) const
+{
+	// Byte address of pixel 'x' in line 'y' is (x + y * width) * bpp / 8,
+	// and getColorDepth() returns log2(bpp) - 1. The raster functions
+	// start at a multiple of 4 pixels and read up to 4 pixels too many.
+	unsigned depth = vdp.getColorDepth();
+	unsigned begin = (((x & ~3) + y * vdp.getImageWidth()) << depth) / 4;
+	unsigned size = (((width + 8) << depth) / 4) + 1;
+	uint64_t result = vram.getWriteCountBx(begin, size);
+	if (drawCursors) {
+		// cursor attribute and pattern tables
+		result += vram.getWriteCountBx(0x7fe00, 0x200);
+	}
+	return result;
+}
+
 } // namespace openmsx
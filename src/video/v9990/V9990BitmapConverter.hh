@@ -29,6 +29,12 @@ public:
 	void convertLine(std::span<Pixel> dst, unsigned x, unsigned y,
 		         int cursorY, bool drawCursors) const;
 
+	/** Sum of the VRAM write counters (see V9990VRAM::getWriteCount())
+	  * of all VRAM that convertLine() reads for the given parameters.
+	  */
+	[[nodiscard]] uint64_t getVRAMWriteCount(
+		unsigned x, unsigned y, unsigned width, bool drawCursors) const;
+
 	/** Set a different rendering mode.
 	  */
 	void setColorMode(V9990ColorMode colorMode_, V9990DisplayMode display) {
@@ -3,11 +3,12 @@
 #include "V9990.hh"
 #include "V9990VRAM.hh"
 #include "V9990DisplayTiming.hh"
+#include "V9990LMMM.hh"
+#include "V9990LogOp.hh"
 #include "MSXMotherBoard.hh"
 #include "RenderSettings.hh"
 #include "BooleanSetting.hh"
 #include "EnumSetting.hh"
-#include "MemBuffer.hh"
 #include "Clock.hh"
 
 #include "checked_cast.hh"
@@ -16,6 +17,7 @@
 #include "unreachable.hh"
 #include "xrange.hh"
 
+#include <algorithm>
 #include <array>
 #include <cassert>
 #include <iostream>
@@ -23,6 +25,8 @@
 
 namespace openmsx {
 
+using LogOpMode = V9990LogOp::Mode;
+
 static constexpr unsigned maxLength = 171; // The maximum value from the xxx_TIMING tables below
 static constexpr EmuDuration d_(unsigned x)
 {
@@ -105,180 +109,6 @@ static constexpr std::array SRCH_TIMING = {
 
 
 
-// Lazily initialized LUT to speed up logical operations:
-//  - 1st index is the mode: 2,4,8 bpp or 'not-transparent'
-//  - 2nd index is the logical operation: one of the 16 possible binary functions
-// * Each entry contains a 256x256 byte array, that array is indexed using
-//   destination and source byte (in that order).
-// * A fully populated logOpLUT would take 4MB, however the vast majority of
-//   this table is (almost) never used. So we save quite some memory (and
-//   startup time) by lazily initializing this table.
-static std::array<std::array<MemBuffer<byte>, 16>, 4> logOpLUT;
-
-// to speedup calculating logOpLUT
-static constexpr auto bitLUT = [] {
-	std::array<std::array<std::array<std::array<byte, 2>, 2>, 16>, 8> result = {};
-	for (auto op : xrange(16)) {
-		unsigned tmp = op;
-		for (auto src : xrange(2)) {
-			for (auto dst : xrange(2)) {
-				unsigned b = tmp & 1;
-				for (auto bit : xrange(8)) {
-					result[bit][op][src][dst] = narrow<byte>(b << bit);
-				}
-				tmp >>= 1;
-			}
-		}
-	}
-	return result;
-}();
-
-enum { LOG_NO_T, LOG_BPP2, LOG_BPP4, LOG_BPP8 };
-
-[[nodiscard]] static constexpr byte func01(unsigned op, unsigned src, unsigned dst)
-{
-	if ((src & 0x03) == 0) return dst & 0x03;
-	byte res = 0;
-	res |= bitLUT[0][op][(src & 0x01) >> 0][(dst & 0x01) >> 0];
-	res |= bitLUT[1][op][(src & 0x02) >> 1][(dst & 0x02) >> 1];
-	return res;
-}
-[[nodiscard]] static constexpr byte func23(unsigned op, unsigned src, unsigned dst)
-{
-	if ((src & 0x0C) == 0) return dst & 0x0C;
-	byte res = 0;
-	res |= bitLUT[2][op][(src & 0x04) >> 2][(dst & 0x04) >> 2];
-	res |= bitLUT[3][op][(src & 0x08) >> 3][(dst & 0x08) >> 3];
-	return res;
-}
-[[nodiscard]] static constexpr byte func45(unsigned op, unsigned src, unsigned dst)
-{
-	if ((src & 0x30) == 0) return dst & 0x30;
-	byte res = 0;
-	res |= bitLUT[4][op][(src & 0x10) >> 4][(dst & 0x10) >> 4];
-	res |= bitLUT[5][op][(src & 0x20) >> 5][(dst & 0x20) >> 5];
-	return res;
-}
-[[nodiscard]] static constexpr byte func67(unsigned op, unsigned src, unsigned dst)
-{
-	if ((src & 0xC0) == 0) return dst & 0xC0;
-	byte res = 0;
-	res |= bitLUT[6][op][(src & 0x40) >> 6][(dst & 0x40) >> 6];
-	res |= bitLUT[7][op][(src & 0x80) >> 7][(dst & 0x80) >> 7];
-	return res;
-}
-
-[[nodiscard]] static constexpr byte func03(unsigned op, unsigned src, unsigned dst)
-{
-	if ((src & 0x0F) == 0) return dst & 0x0F;
-	byte res = 0;
-	res |= bitLUT[0][op][(src & 0x01) >> 0][(dst & 0x01) >> 0];
-	res |= bitLUT[1][op][(src & 0x02) >> 1][(dst & 0x02) >> 1];
-	res |= bitLUT[2][op][(src & 0x04) >> 2][(dst & 0x04) >> 2];
-	res |= bitLUT[3][op][(src & 0x08) >> 3][(dst & 0x08) >> 3];
-	return res;
-}
-[[nodiscard]] static constexpr byte func47(unsigned op, unsigned src, unsigned dst)
-{
-	if ((src & 0xF0) == 0) return dst & 0xF0;
-	byte res = 0;
-	res |= bitLUT[4][op][(src & 0x10) >> 4][(dst & 0x10) >> 4];
-	res |= bitLUT[5][op][(src & 0x20) >> 5][(dst & 0x20) >> 5];
-	res |= bitLUT[6][op][(src & 0x40) >> 6][(dst & 0x40) >> 6];
-	res |= bitLUT[7][op][(src & 0x80) >> 7][(dst & 0x80) >> 7];
-	return res;
-}
-
-[[nodiscard]] static constexpr byte func07(unsigned op, unsigned src, unsigned dst)
-{
-	// if (src == 0) return dst;  // handled in fillTable8
-	byte res = 0;
-	res |= bitLUT[0][op][(src & 0x01) >> 0][(dst & 0x01) >> 0];
-	res |= bitLUT[1][op][(src & 0x02) >> 1][(dst & 0x02) >> 1];
-	res |= bitLUT[2][op][(src & 0x04) >> 2][(dst & 0x04) >> 2];
-	res |= bitLUT[3][op][(src & 0x08) >> 3][(dst & 0x08) >> 3];
-	res |= bitLUT[4][op][(src & 0x10) >> 4][(dst & 0x10) >> 4];
-	res |= bitLUT[5][op][(src & 0x20) >> 5][(dst & 0x20) >> 5];
-	res |= bitLUT[6][op][(src & 0x40) >> 6][(dst & 0x40) >> 6];
-	res |= bitLUT[7][op][(src & 0x80) >> 7][(dst & 0x80) >> 7];
-	return res;
-}
-
-static constexpr void fillTableNoT(unsigned op, std::span<byte, 256 * 256> table)
-{
-	for (auto dst : xrange(256)) {
-		for (auto src : xrange(256)) {
-			table[dst * 256 + src] = func07(op, src, dst);
-		}
-	}
-}
-
-static constexpr void fillTable2(unsigned op, std::span<byte, 256 * 256> table)
-{
-	for (auto dst : xrange(256)) {
-		for (auto src : xrange(256)) {
-			byte res = 0;
-			res |= func01(op, src, dst);
-			res |= func23(op, src, dst);
-			res |= func45(op, src, dst);
-			res |= func67(op, src, dst);
-			table[dst * 256 + src] = res;
-		}
-	}
-}
-
-static constexpr void fillTable4(unsigned op, std::span<byte, 256 * 256> table)
-{
-	for (auto dst : xrange(256)) {
-		for (auto src : xrange(256)) {
-			byte res = 0;
-			res |= func03(op, src, dst);
-			res |= func47(op, src, dst);
-			table[dst * 256 + src] = res;
-		}
-	}
-}
-
-static constexpr void fillTable8(unsigned op, std::span<byte, 256 * 256> table)
-{
-	for (auto dst : xrange(256)) {
-		{ // src == 0
-			table[dst * 256 + 0  ] = narrow_cast<byte>(dst);
-		}
-		for (auto src : xrange(1, 256)) { // src != 0
-			table[dst * 256 + src] = func07(op, src, dst);
-		}
-	}
-}
-
-[[nodiscard]] static std::span<const byte, 256 * 256> getLogOpImpl(unsigned mode, unsigned op)
-{
-	op &= 0x0f;
-	auto& lut = logOpLUT[mode][op];
-	if (!lut.data()) {
-		lut.resize(256 * 256);
-		std::span<byte, 256 * 256> s{lut.data(), 256 * 256};
-		switch (mode) {
-		case LOG_NO_T:
-			fillTableNoT(op, s);
-			break;
-		case LOG_BPP2:
-			fillTable2(op, s);
-			break;
-		case LOG_BPP4:
-			fillTable4(op, s);
-			break;
-		case LOG_BPP8:
-			fillTable8(op, s);
-			break;
-		default:
-			UNREACHABLE;
-		}
-	}
-	return std::span<byte, 256 * 256>{lut.data(), 256 * 256};
-}
-
-
 static constexpr byte DIY = 0x08;
 static constexpr byte DIX = 0x04;
 static constexpr byte NEQ = 0x02;
@@ -319,7 +149,7 @@ inline byte V9990CmdEngine::V9990P1::shiftMask(unsigned x)
 
 inline std::span<const byte, 256 * 256> V9990CmdEngine::V9990P1::getLogOpLUT(byte op)
 {
-	return getLogOpImpl((op & 0x10) ? LOG_BPP4 : LOG_NO_T, op);
+	return V9990LogOp::getLUT((op & 0x10) ? LogOpMode::BPP4 : LogOpMode::NO_T, op);
 }
 
 inline byte V9990CmdEngine::V9990P1::logOp(
@@ -387,7 +217,7 @@ inline byte V9990CmdEngine::V9990P2::shiftMask(unsigned x)
 
 inline std::span<const byte, 256 * 256> V9990CmdEngine::V9990P2::getLogOpLUT(byte op)
 {
-	return getLogOpImpl((op & 0x10) ? LOG_BPP4 : LOG_NO_T, op);
+	return V9990LogOp::getLUT((op & 0x10) ? LogOpMode::BPP4 : LogOpMode::NO_T, op);
 }
 
 inline byte V9990CmdEngine::V9990P2::logOp(
@@ -455,7 +285,7 @@ inline byte V9990CmdEngine::V9990Bpp2::shiftMask(unsigned x)
 
 inline std::span<const byte, 256 * 256> V9990CmdEngine::V9990Bpp2::getLogOpLUT(byte op)
 {
-	return getLogOpImpl((op & 0x10) ? LOG_BPP2 : LOG_NO_T, op);
+	return V9990LogOp::getLUT((op & 0x10) ? LogOpMode::BPP2 : LogOpMode::NO_T, op);
 }
 
 inline byte V9990CmdEngine::V9990Bpp2::logOp(
@@ -523,7 +353,7 @@ inline byte V9990CmdEngine::V9990Bpp4::shiftMask(unsigned x)
 
 inline std::span<const byte, 256 * 256> V9990CmdEngine::V9990Bpp4::getLogOpLUT(byte op)
 {
-	return getLogOpImpl((op & 0x10) ? LOG_BPP4 : LOG_NO_T, op);
+	return V9990LogOp::getLUT((op & 0x10) ? LogOpMode::BPP4 : LogOpMode::NO_T, op);
 }
 
 inline byte V9990CmdEngine::V9990Bpp4::logOp(
@@ -560,27 +390,30 @@ inline void V9990CmdEngine::V9990Bpp4::psetColor(
 }
 
 // 8 bpp --------------------------------------------------------------
+// shared with the LMMM implementation, see V9990LMMM.hh
+using LMMMBpp8 = V9990LMMM::Bpp8<V9990VRAM>;
+
 inline unsigned V9990CmdEngine::V9990Bpp8::getPitch(unsigned width)
 {
-	return width;
+	return LMMMBpp8::getPitch(width);
 }
 
 inline unsigned V9990CmdEngine::V9990Bpp8::addressOf(
 	unsigned x, unsigned y, unsigned pitch)
 {
-	return V9990VRAM::transformBx((x & (pitch - 1)) + y * pitch) & 0x7FFFF;
+	return LMMMBpp8::addressOf(x, y, pitch);
 }
 
 inline byte V9990CmdEngine::V9990Bpp8::point(
 	const V9990VRAM& vram, unsigned x, unsigned y, unsigned pitch)
 {
-	return vram.readVRAMDirect(addressOf(x, y, pitch));
+	return LMMMBpp8::point(vram, x, y, pitch);
 }
 
 inline byte V9990CmdEngine::V9990Bpp8::shift(
-	byte value, unsigned /*fromX*/, unsigned /*toX*/)
+	byte value, unsigned fromX, unsigned toX)
 {
-	return value;
+	return LMMMBpp8::shift(value, fromX, toX);
 }
 
 inline byte V9990CmdEngine::V9990Bpp8::shiftMask(unsigned /*x*/)
@@ -590,25 +423,20 @@ inline byte V9990CmdEngine::V9990Bpp8::shiftMask(unsigned /*x*/)
 
 inline std::span<const byte, 256 * 256> V9990CmdEngine::V9990Bpp8::getLogOpLUT(byte op)
 {
-	return getLogOpImpl((op & 0x10) ? LOG_BPP8 : LOG_NO_T, op);
+	return LMMMBpp8::getLogOpLUT(op);
 }
 
 inline byte V9990CmdEngine::V9990Bpp8::logOp(
 	std::span<const byte, 256 * 256> lut, byte src, byte dst)
 {
-	return lut[256 * dst + src];
+	return V9990LogOp::logOp8(lut, src, dst);
 }
 
 inline void V9990CmdEngine::V9990Bpp8::pset(
 	V9990VRAM& vram, unsigned x, unsigned y, unsigned pitch,
-	byte srcColor, word mask, std::span<const byte, 256 * 256> lut, byte /*op*/)
+	byte srcColor, word mask, std::span<const byte, 256 * 256> lut, byte op)
 {
-	unsigned addr = addressOf(x, y, pitch);
-	byte dstColor = vram.readVRAMDirect(addr);
-	byte newColor = logOp(lut, srcColor, dstColor);
-	byte mask1 = narrow_cast<byte>((addr & 0x40000) ? (mask >> 8) : (mask & 0xFF));
-	byte result = (dstColor & ~mask1) | (newColor & mask1);
-	vram.writeVRAMDirect(addr, result);
+	LMMMBpp8::pset(vram, x, y, pitch, srcColor, mask, lut, op);
 }
 
 inline void V9990CmdEngine::V9990Bpp8::psetColor(
@@ -618,38 +446,42 @@ inline void V9990CmdEngine::V9990Bpp8::psetColor(
 	unsigned addr = addressOf(x, y, pitch);
 	byte srcColor = narrow_cast<byte>((addr & 0x40000) ? (color >> 8) : (color & 0xFF));
 	byte dstColor = vram.readVRAMDirect(addr);
-	byte newColor = logOp(lut, srcColor, dstColor);
 	byte mask1 = narrow_cast<byte>((addr & 0x40000) ? (mask >> 8) : (mask & 0xFF));
-	byte result = (dstColor & ~mask1) | (newColor & mask1);
-	vram.writeVRAMDirect(addr, result);
+	vram.writeVRAMDirect(addr, V9990LogOp::apply8(lut, srcColor, dstColor, mask1));
+}
+
+inline void V9990CmdEngine::V9990Bpp8::psetImp(
+	V9990VRAM& vram, unsigned x, unsigned y, unsigned pitch,
+	byte srcColor, word mask, bool transp)
+{
+	LMMMBpp8::psetImp(vram, x, y, pitch, srcColor, mask, transp);
 }
 
 // 16 bpp -------------------------------------------------------------
+// shared with the LMMM implementation, see V9990LMMM.hh
+using LMMMBpp16 = V9990LMMM::Bpp16<V9990VRAM>;
+
 inline unsigned V9990CmdEngine::V9990Bpp16::getPitch(unsigned width)
 {
-	//return width * 2;
-	return width;
+	return LMMMBpp16::getPitch(width);
 }
 
 inline unsigned V9990CmdEngine::V9990Bpp16::addressOf(
 	unsigned x, unsigned y, unsigned pitch)
 {
-	//return V9990VRAM::transformBx(((x * 2) & (pitch - 1)) + y * pitch) & 0x7FFFF;
-	return ((x & (pitch - 1)) + y * pitch) & 0x3FFFF;
+	return LMMMBpp16::addressOf(x, y, pitch);
 }
 
 inline word V9990CmdEngine::V9990Bpp16::point(
 	const V9990VRAM& vram, unsigned x, unsigned y, unsigned pitch)
 {
-	unsigned addr = addressOf(x, y, pitch);
-	return word(vram.readVRAMDirect(addr + 0x00000) +
-	            vram.readVRAMDirect(addr + 0x40000) * 256);
+	return LMMMBpp16::point(vram, x, y, pitch);
 }
 
 inline word V9990CmdEngine::V9990Bpp16::shift(
-	word value, unsigned /*fromX*/, unsigned /*toX*/)
+	word value, unsigned fromX, unsigned toX)
 {
-	return value;
+	return LMMMBpp16::shift(value, fromX, toX);
 }
 
 inline word V9990CmdEngine::V9990Bpp16::shiftMask(unsigned /*x*/)
@@ -659,28 +491,20 @@ inline word V9990CmdEngine::V9990Bpp16::shiftMask(unsigned /*x*/)
 
 inline std::span<const byte, 256 * 256> V9990CmdEngine::V9990Bpp16::getLogOpLUT(byte op)
 {
-	return getLogOpImpl(LOG_NO_T, op);
+	return LMMMBpp16::getLogOpLUT(op);
 }
 
 inline word V9990CmdEngine::V9990Bpp16::logOp(
 	std::span<const byte, 256 * 256> lut, word src, word dst, bool transp)
 {
-	if (transp && (src == 0)) return dst;
-	return word((lut[((dst & 0x00FF) << 8) + ((src & 0x00FF) >> 0)] << 0) +
-	            (lut[((dst & 0xFF00) << 0) + ((src & 0xFF00) >> 8)] << 8));
+	return V9990LogOp::logOp16(lut, src, dst, transp);
 }
 
 inline void V9990CmdEngine::V9990Bpp16::pset(
 	V9990VRAM& vram, unsigned x, unsigned y, unsigned pitch,
 	word srcColor, word mask, std::span<const byte, 256 * 256> lut, byte op)
 {
-	unsigned addr = addressOf(x, y, pitch);
-	auto dstColor = word(vram.readVRAMDirect(addr + 0x00000) +
-	                     vram.readVRAMDirect(addr + 0x40000) * 256);
-	word newColor = logOp(lut, srcColor, dstColor, (op & 0x10) != 0);
-	word result = (dstColor & ~mask) | (newColor & mask);
-	vram.writeVRAMDirect(addr + 0x00000, narrow_cast<byte>(result & 0xFF));
-	vram.writeVRAMDirect(addr + 0x40000, narrow_cast<byte>(result >> 8));
+	LMMMBpp16::pset(vram, x, y, pitch, srcColor, mask, lut, op);
 }
 
 inline void V9990CmdEngine::V9990Bpp16::psetColor(
@@ -690,12 +514,18 @@ inline void V9990CmdEngine::V9990Bpp16::psetColor(
 	unsigned addr = addressOf(x, y, pitch);
 	auto dstColor = word(vram.readVRAMDirect(addr + 0x00000) +
 	                     vram.readVRAMDirect(addr + 0x40000) * 256);
-	word newColor = logOp(lut, srcColor, dstColor, (op & 0x10) != 0);
-	word result = (dstColor & ~mask) | (newColor & mask);
+	word result = V9990LogOp::apply16(lut, srcColor, dstColor, mask, (op & 0x10) != 0);
 	vram.writeVRAMDirect(addr + 0x00000, narrow_cast<byte>(result & 0xFF));
 	vram.writeVRAMDirect(addr + 0x40000, narrow_cast<byte>(result >> 8));
 }
 
+inline void V9990CmdEngine::V9990Bpp16::psetImp(
+	V9990VRAM& vram, unsigned x, unsigned y, unsigned pitch,
+	word srcColor, word mask, bool transp)
+{
+	LMMMBpp16::psetImp(vram, x, y, pitch, srcColor, mask, transp);
+}
+
 // ====================================================================
 /** Constructor
   */
@@ -1133,34 +963,32 @@ void V9990CmdEngine::startLMMM(EmuTime::param time)
 template<typename Mode>
 void V9990CmdEngine::executeLMMM(EmuTime::param limit)
 {
-	// TODO can be optimized a lot
-
+	V9990LMMM::Regs r = {
+		.SX = SX, .SY = SY, .DX = DX, .DY = DY,
+		.ANX = ANX, .ANY = ANY,
+		.NX = NX, .wrappedNX = getWrappedNX(),
+		.WM = WM,
+		.dx = (ARG & DIX) ? word(-1) : word(1),
+		.dy = (ARG & DIY) ? word(-1) : word(1),
+		.LOG = LOG,
+	};
 	auto delta = getTiming(*this, LMMM_TIMING);
 	unsigned pitch = Mode::getPitch(vdp.getImageWidth());
-	word dx = (ARG & DIX) ? word(-1) : 1;
-	word dy = (ARG & DIY) ? word(-1) : 1;
-	auto lut = Mode::getLogOpLUT(LOG);
-	while (engineTime < limit) {
-		engineTime += delta;
-		auto src = Mode::point(vram, SX, SY, pitch);
-		src = Mode::shift(src, SX, DX);
-		Mode::pset(vram, DX, DY, pitch, src, WM, lut, LOG);
-
-		DX += dx;
-		SX += dx;
-		if (!--ANX) {
-			DX -= word(NX * dx);
-			SX -= word(NX * dx);
-			DY += dy;
-			SY += dy;
-			if (!--ANY) {
-				cmdReady(engineTime);
-				return;
-			} else {
-				ANX = getWrappedNX();
+	bool ready = [&] {
+		if constexpr (Mode::BITS_PER_PIXEL >= 8) {
+			if (V9990LogOp::isImp(LOG)) {
+				return V9990LMMM::executeImp<Mode>(vram, r, pitch, delta, engineTime, limit);
 			}
 		}
-	}
+		return V9990LMMM::execute<Mode>(vram, r, pitch, delta, engineTime, limit);
+	}();
+	SX = r.SX;
+	SY = r.SY;
+	DX = r.DX;
+	DY = r.DY;
+	ANX = r.ANX;
+	ANY = r.ANY;
+	if (ready) cmdReady(engineTime);
 }
 
 // CMMC
@@ -197,6 +197,9 @@ private:
 		static void psetColor(
 			V9990VRAM& vram, unsigned x, unsigned y, unsigned pitch,
 			word color, word mask, std::span<const byte, 256 * 256> lut, byte op);
+		static void psetImp(
+			V9990VRAM& vram, unsigned x, unsigned y, unsigned pitch,
+			byte srcColor, word mask, bool transp);
 	};
 
 	class V9990Bpp16 {
@@ -218,6 +221,9 @@ private:
 		static void psetColor(
 			V9990VRAM& vram, unsigned x, unsigned y, unsigned pitch,
 			word color, word mask, std::span<const byte, 256 * 256> lut, byte op);
+		static void psetImp(
+			V9990VRAM& vram, unsigned x, unsigned y, unsigned pitch,
+			word srcColor, word mask, bool transp);
 	};
 
 	void startSTOP  (EmuTime::param time);
@@ -0,0 +1,213 @@
+#ifndef V9990LMMM_HH
+#define V9990LMMM_HH
+
+#include "V9990LogOp.hh"
+#include "V9990VRAM.hh"
+
+#include "EmuTime.hh"
+#include "narrow.hh"
+#include "openmsx.hh"
+#include "xrange.hh"
+
+#include <algorithm>
+#include <span>
+
+namespace openmsx::V9990LMMM {
+
+/** The LMMM (logical move VRAM to VRAM) command of the V9990 command
+  * engine. It's in a header and templatized on the VRAM type so that the
+  * unittest can run the generic and the IMP/TIMP specialized versions
+  * against each other on plain memory. 'VRAM' must offer readVRAMDirect()
+  * and writeVRAMDirect() like V9990VRAM does.
+  */
+
+/** Pixel access in the 8bpp Bx modes. */
+template<typename VRAM> struct Bpp8
+{
+	using Type = byte;
+	static constexpr word BITS_PER_PIXEL = 8;
+
+	[[nodiscard]] static unsigned getPitch(unsigned width) {
+		return width;
+	}
+	[[nodiscard]] static unsigned addressOf(unsigned x, unsigned y, unsigned pitch) {
+		return V9990VRAM::transformBx((x & (pitch - 1)) + y * pitch) & 0x7FFFF;
+	}
+	[[nodiscard]] static byte point(const VRAM& vram, unsigned x, unsigned y, unsigned pitch) {
+		return vram.readVRAMDirect(addressOf(x, y, pitch));
+	}
+	[[nodiscard]] static byte shift(byte value, unsigned /*fromX*/, unsigned /*toX*/) {
+		return value;
+	}
+	[[nodiscard]] static std::span<const byte, 256 * 256> getLogOpLUT(byte op) {
+		return V9990LogOp::getLUT((op & 0x10) ? V9990LogOp::Mode::BPP8 : V9990LogOp::Mode::NO_T, op);
+	}
+	static void pset(
+		VRAM& vram, unsigned x, unsigned y, unsigned pitch,
+		byte srcColor, word mask, std::span<const byte, 256 * 256> lut, byte /*op*/)
+	{
+		unsigned addr = addressOf(x, y, pitch);
+		byte dstColor = vram.readVRAMDirect(addr);
+		byte mask1 = narrow_cast<byte>((addr & 0x40000) ? (mask >> 8) : (mask & 0xFF));
+		vram.writeVRAMDirect(addr, V9990LogOp::apply8(lut, srcColor, dstColor, mask1));
+	}
+	/** Same VRAM content as pset() with logical operation IMP (or TIMP),
+	  * but without the LUT lookup. Unlike pset(), nothing is written for
+	  * a transparent source pixel.
+	  */
+	static void psetImp(
+		VRAM& vram, unsigned x, unsigned y, unsigned pitch,
+		byte srcColor, word mask, bool transp)
+	{
+		unsigned addr = addressOf(x, y, pitch);
+		byte mask1 = narrow_cast<byte>((addr & 0x40000) ? (mask >> 8) : (mask & 0xFF));
+		// destination is not needed when all bits get overwritten
+		byte dstColor = (mask1 == 0xFF) ? 0 : vram.readVRAMDirect(addr);
+		if (auto result = V9990LogOp::imp8(srcColor, dstColor, mask1, transp)) {
+			vram.writeVRAMDirect(addr, *result);
+		}
+	}
+};
+
+/** Pixel access in the 16bpp Bx modes. */
+template<typename VRAM> struct Bpp16
+{
+	using Type = word;
+	static constexpr word BITS_PER_PIXEL = 16;
+
+	[[nodiscard]] static unsigned getPitch(unsigned width) {
+		//return width * 2;
+		return width;
+	}
+	[[nodiscard]] static unsigned addressOf(unsigned x, unsigned y, unsigned pitch) {
+		//return V9990VRAM::transformBx(((x * 2) & (pitch - 1)) + y * pitch) & 0x7FFFF;
+		return ((x & (pitch - 1)) + y * pitch) & 0x3FFFF;
+	}
+	[[nodiscard]] static word point(const VRAM& vram, unsigned x, unsigned y, unsigned pitch) {
+		unsigned addr = addressOf(x, y, pitch);
+		return word(vram.readVRAMDirect(addr + 0x00000) +
+		            vram.readVRAMDirect(addr + 0x40000) * 256);
+	}
+	[[nodiscard]] static word shift(word value, unsigned /*fromX*/, unsigned /*toX*/) {
+		return value;
+	}
+	[[nodiscard]] static std::span<const byte, 256 * 256> getLogOpLUT(byte op) {
+		return V9990LogOp::getLUT(V9990LogOp::Mode::NO_T, op);
+	}
+	static void pset(
+		VRAM& vram, unsigned x, unsigned y, unsigned pitch,
+		word srcColor, word mask, std::span<const byte, 256 * 256> lut, byte op)
+	{
+		unsigned addr = addressOf(x, y, pitch);
+		auto dstColor = word(vram.readVRAMDirect(addr + 0x00000) +
+		                     vram.readVRAMDirect(addr + 0x40000) * 256);
+		word result = V9990LogOp::apply16(lut, srcColor, dstColor, mask, (op & 0x10) != 0);
+		vram.writeVRAMDirect(addr + 0x00000, narrow_cast<byte>(result & 0xFF));
+		vram.writeVRAMDirect(addr + 0x40000, narrow_cast<byte>(result >> 8));
+	}
+	/** See Bpp8::psetImp(). */
+	static void psetImp(
+		VRAM& vram, unsigned x, unsigned y, unsigned pitch,
+		word srcColor, word mask, bool transp)
+	{
+		unsigned addr = addressOf(x, y, pitch);
+		// destination is not needed when all bits get overwritten
+		auto dstColor = (mask == 0xFFFF) ? word(0)
+		              : word(vram.readVRAMDirect(addr + 0x00000) +
+		                     vram.readVRAMDirect(addr + 0x40000) * 256);
+		if (auto result = V9990LogOp::imp16(srcColor, dstColor, mask, transp)) {
+			vram.writeVRAMDirect(addr + 0x00000, narrow_cast<byte>(*result & 0xFF));
+			vram.writeVRAMDirect(addr + 0x40000, narrow_cast<byte>(*result >> 8));
+		}
+	}
+};
+
+/** Command engine registers used by LMMM. */
+struct Regs
+{
+	word SX, SY, DX, DY;
+	word ANX, ANY;   // remaining width of the current row, remaining rows
+	word NX;
+	word wrappedNX;  // value to reload ANX with (NX, or 2048 when NX is 0)
+	word WM;
+	word dx, dy;     // +1 or -1, from the DIX/DIY bits of ARG
+	byte LOG;
+};
+
+/** Execute LMMM until 'limit' (or until the command is finished).
+  * Every pixel takes 'delta', all pixels are done at once when 'delta' is
+  * zero. Works in every display mode (the 'Mode' classes of V9990CmdEngine).
+  * @return true iff the command is finished, 'time' is then the moment it
+  *         finished.
+  */
+template<typename Mode, typename VRAM>
+[[nodiscard]] bool execute(VRAM& vram, Regs& r, unsigned pitch,
+                           EmuDuration delta, EmuTime& time, EmuTime::param limit)
+{
+	auto lut = Mode::getLogOpLUT(r.LOG);
+	while (time < limit) {
+		time += delta;
+		auto src = Mode::point(vram, r.SX, r.SY, pitch);
+		src = Mode::shift(src, r.SX, r.DX);
+		Mode::pset(vram, r.DX, r.DY, pitch, src, r.WM, lut, r.LOG);
+
+		r.DX += r.dx;
+		r.SX += r.dx;
+		if (!--r.ANX) {
+			r.DX -= word(r.NX * r.dx);
+			r.SX -= word(r.NX * r.dx);
+			r.DY += r.dy;
+			r.SY += r.dy;
+			if (!--r.ANY) {
+				return true;
+			} else {
+				r.ANX = r.wrappedNX;
+			}
+		}
+	}
+	return false;
+}
+
+/** Specialized version of execute() for the common case of a plain copy
+  * (logical operation IMP or TIMP, see V9990LogOp::isImp()) in the 8bpp and
+  * 16bpp modes. This handles a whole row (or the part of it before 'limit')
+  * in one tight loop. The resulting VRAM content and registers are the same
+  * as with execute(), but transparent source pixels are skipped instead of
+  * being written back unchanged.
+  */
+template<typename Mode, typename VRAM>
+[[nodiscard]] bool executeImp(VRAM& vram, Regs& r, unsigned pitch,
+                              EmuDuration delta, EmuTime& time, EmuTime::param limit)
+{
+	bool transp = (r.LOG & 0x10) != 0;
+	while (time < limit) {
+		unsigned num = (delta != EmuDuration::zero())
+		             ? std::min<unsigned>((limit - time).divUp(delta), r.ANX)
+		             : r.ANX;
+		for (auto i : xrange(num)) {
+			(void)i;
+			auto src = Mode::point(vram, r.SX, r.SY, pitch);
+			Mode::psetImp(vram, r.DX, r.DY, pitch, src, r.WM, transp);
+			r.DX += r.dx;
+			r.SX += r.dx;
+		}
+		time += delta * num;
+		r.ANX = narrow_cast<word>(r.ANX - num);
+		if (!r.ANX) {
+			r.DX -= word(r.NX * r.dx);
+			r.SX -= word(r.NX * r.dx);
+			r.DY += r.dy;
+			r.SY += r.dy;
+			if (!--r.ANY) {
+				return true;
+			} else {
+				r.ANX = r.wrappedNX;
+			}
+		}
+	}
+	return false;
+}
+
+} // namespace openmsx::V9990LMMM
+
+#endif
@@ -0,0 +1,93 @@
+#ifndef V9990LOGOP_HH
+#define V9990LOGOP_HH
+
+#include "openmsx.hh"
+
+#include <cstdint>
+#include <optional>
+#include <span>
+
+namespace openmsx::V9990LogOp {
+
+/** Logical operations of the V9990 command engine, per pixel.
+  * The 16 possible binary functions are implemented with (lazily
+  * initialized) lookup tables, indexed by destination and source byte.
+  * The transparent ('T') variants leave the destination unchanged for
+  * source pixels that are zero. How big such a pixel is depends on the
+  * color depth, hence the different table kinds.
+  */
+enum class Mode : uint8_t {
+	NO_T, // not-transparent (or 16bpp, see logOp16())
+	BPP2, // transparent, 2 bits per pixel
+	BPP4, // transparent, 4 bits per pixel
+	BPP8, // transparent, 8 bits per pixel
+};
+
+/** Is 'op' the logical operation IMP or TIMP (a plain copy)? For those
+  * the LUT can be bypassed, see imp8() and imp16().
+  */
+[[nodiscard]] constexpr bool isImp(unsigned op)
+{
+	return (op & 0x0F) == 0x0C;
+}
+
+/** Get the LUT for the given mode and logical operation (only the lower
+  * 4 bits of 'op' are used).
+  */
+[[nodiscard]] std::span<const byte, 256 * 256> getLUT(Mode mode, unsigned op);
+
+[[nodiscard]] inline byte logOp8(std::span<const byte, 256 * 256> lut, byte src, byte dst)
+{
+	return lut[256 * dst + src];
+}
+
+/** In 16bpp both bytes use the 'NO_T' LUT, transparency applies to the
+  * pixel as a whole.
+  */
+[[nodiscard]] inline word logOp16(
+	std::span<const byte, 256 * 256> lut, word src, word dst, bool transp)
+{
+	if (transp && (src == 0)) return dst;
+	return word((lut[((dst & 0x00FF) << 8) + ((src & 0x00FF) >> 0)] << 0) +
+	            (lut[((dst & 0xFF00) << 0) + ((src & 0xFF00) >> 8)] << 8));
+}
+
+/** Combine one byte of source and destination with the logical operation,
+  * only the bits in 'mask' are changed.
+  */
+[[nodiscard]] inline byte apply8(
+	std::span<const byte, 256 * 256> lut, byte src, byte dst, byte mask)
+{
+	byte newColor = logOp8(lut, src, dst);
+	return (dst & ~mask) | (newColor & mask);
+}
+
+[[nodiscard]] inline word apply16(
+	std::span<const byte, 256 * 256> lut, word src, word dst, word mask, bool transp)
+{
+	word newColor = logOp16(lut, src, dst, transp);
+	return (dst & ~mask) | (newColor & mask);
+}
+
+/** Same result as apply8() (with the BPP8 or NO_T LUT) for logical operation
+  * IMP or TIMP, but without LUT lookup. The destination is only used for
+  * the bits not in 'mask', so it may be anything when 'mask' is 0xFF.
+  * @return nullopt when the destination remains unchanged (transparent
+  *         source pixel).
+  */
+[[nodiscard]] inline std::optional<byte> imp8(byte src, byte dst, byte mask, bool transp)
+{
+	if (transp && (src == 0)) return std::nullopt;
+	return (dst & ~mask) | (src & mask);
+}
+
+/** Like imp8(), but for 16bpp, see apply16(). */
+[[nodiscard]] inline std::optional<word> imp16(word src, word dst, word mask, bool transp)
+{
+	if (transp && (src == 0)) return std::nullopt;
+	return (dst & ~mask) | (src & mask);
+}
+
+} // namespace openmsx::V9990LogOp
+
+#endif
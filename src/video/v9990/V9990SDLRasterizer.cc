@@ -9,6 +9,7 @@
 #include "enumerate.hh"
 #include "narrow.hh"
 #include "one_of.hh"
+#include "ranges.hh"
 #include "xrange.hh"
 #include <algorithm>
 #include <array>
@@ -22,12 +23,13 @@ V9990SDLRasterizer::V9990SDLRasterizer(
 		std::unique_ptr<PostProcessor> postProcessor_)
 	: vdp(vdp_), vram(vdp.getVRAM())
 	, screen(screen_)
-	, workFrame(std::make_unique<RawFrame>(1280, 240))
+	, workFrame(std::make_unique<RawFrame>(LINE_CACHE_WIDTH, SCREEN_HEIGHT))
 	, renderSettings(display.getRenderSettings())
 	, postProcessor(std::move(postProcessor_))
 	, bitmapConverter(vdp, palette64, palette64_32768, palette256, palette256_32768, palette32768)
 	, p1Converter(vdp, palette64)
 	, p2Converter(vdp, palette64)
+	, lineCache(size_t(LINE_CACHE_WIDTH) * SCREEN_HEIGHT)
 {
 	// Fill palettes
 	preCalcPalettes();
@@ -60,6 +62,7 @@ bool V9990SDLRasterizer::isActive()
 
 void V9990SDLRasterizer::reset()
 {
+	invalidateLineCache();
 	setDisplayMode(vdp.getDisplayMode());
 	setColorMode(vdp.getColorMode());
 	resetPalette();
@@ -97,12 +100,14 @@ void V9990SDLRasterizer::setDisplayMode(V9990DisplayMode mode)
 {
 	displayMode = mode;
 	bitmapConverter.setColorMode(colorMode, displayMode);
+	invalidateLineCache();
 }
 
 void V9990SDLRasterizer::setColorMode(V9990ColorMode mode)
 {
 	colorMode = mode;
 	bitmapConverter.setColorMode(colorMode, displayMode);
+	invalidateLineCache();
 }
 
 void V9990SDLRasterizer::drawBorder(
@@ -259,8 +264,14 @@ void V9990SDLRasterizer::drawBxMode(
 		// position of the borders into account, the display area
 		// plus 3 pixels cannot go beyond the end of the buffer.
 		unsigned y = scrollYBase + ((displayYA + scrollY) & rollMask);
-		auto dst = workFrame->getLineDirect(fromY).subspan(fromX, displayWidth);
-		bitmapConverter.convertLine(dst, x, y, cursorY, drawSprites);
+		LineCacheKey key = {
+			bitmapConverter.getVRAMWriteCount(x, y, displayWidth, drawSprites),
+			vdp.getRegisterChangeCount(),
+			fromX, displayWidth, int(x), int(y), cursorY,
+			drawSprites, vdp.getEvenOdd()};
+		drawCachedLine(fromY, key, [&](std::span<Pixel> dst) {
+			bitmapConverter.convertLine(dst, x, y, cursorY, drawSprites);
+		});
 		workFrame->setLineWidth(fromY, vdp.getLineWidth());
 		++fromY;
 		displayYA += lineStep;
@@ -268,6 +279,28 @@ void V9990SDLRasterizer::drawBxMode(
 	}
 }
 
+template<typename ConvertLine>
+void V9990SDLRasterizer::drawCachedLine(
+	int y, const LineCacheKey& key, ConvertLine convertLine)
+{
+	auto dst = workFrame->getLineDirect(y).subspan(key.fromX, key.width);
+	auto cached = std::span{lineCache}.subspan(
+		size_t(y) * LINE_CACHE_WIDTH + key.fromX, key.width);
+	auto& cachedKey = lineCacheKeys[y];
+	if (cachedKey == key) {
+		// Nothing changed since the last time this line was drawn.
+		ranges::copy(cached, dst);
+	} else {
+		convertLine(dst);
+		ranges::copy(dst, cached);
+		cachedKey = key;
+	}
+}
+
+void V9990SDLRasterizer::invalidateLineCache()
+{
+	ranges::fill(lineCacheKeys, std::nullopt);
+}
 
 void V9990SDLRasterizer::preCalcPalettes()
 {
@@ -323,6 +356,7 @@ void V9990SDLRasterizer::setPalette(int index,
 	palette64_32768[index & 63] = narrow<int16_t>(idx32768); // TODO what with ys?
 	palette64[index & 63] = ys ? screen.getKeyColor()
 	                           : palette32768[idx32768];
+	invalidateLineCache();
 }
 
 void V9990SDLRasterizer::resetPalette()
@@ -334,6 +368,7 @@ void V9990SDLRasterizer::resetPalette()
 	}
 	palette256[0] = vdp.isSuperimposing() ? screen.getKeyColor()
 	                                      : palette32768[0];
+	invalidateLineCache();
 	// TODO what with palette256_32768[0]?
 }
 
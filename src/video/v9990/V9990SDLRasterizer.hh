@@ -10,6 +10,9 @@
 #include <array>
 #include <cstdint>
 #include <memory>
+#include <optional>
+#include <span>
+#include <vector>
 
 namespace openmsx {
 
@@ -73,6 +76,28 @@ public:
 	// Observer<Setting>
 	void update(const Setting& setting) noexcept override;
 
+private:
+	/** All inputs that determine the content of a (partial) bitmap mode
+	  * display line. When the key of a line equals the key from the
+	  * previous time this line was drawn, the converted pixels can be
+	  * copied from the cache instead of converting the line again.
+	  * 'vramWriteCount' only covers the VRAM that this particular line
+	  * reads, so writes elsewhere in VRAM don't invalidate the line.
+	  */
+	struct LineCacheKey {
+		uint64_t vramWriteCount;
+		uint64_t registerChangeCount;
+		int fromX, width;
+		int displayX, displayY, cursorY;
+		bool drawSprites;
+		bool evenOdd;
+		[[nodiscard]] bool operator==(const LineCacheKey&) const = default;
+	};
+	template<typename ConvertLine>
+	void drawCachedLine(int y, const LineCacheKey& key,
+	                    ConvertLine convertLine);
+	void invalidateLineCache();
+
 private:
 	/** screen width for SDLLo
 	  */
@@ -82,6 +107,10 @@ private:
 	  */
 	static constexpr int SCREEN_HEIGHT = 240;
 
+	/** width of the work frame (and of each line in the line cache)
+	  */
+	static constexpr int LINE_CACHE_WIDTH = 1280;
+
 	/** The VDP of which the video output is being rendered.
 	  */
 	V9990& vdp;
@@ -143,6 +172,14 @@ private:
 	V9990BitmapConverter bitmapConverter;
 	V9990P1Converter p1Converter;
 	V9990P2Converter p2Converter;
+
+	/** Converted pixels of the most recently drawn (part of each) bitmap
+	  * mode line, and the inputs that were used to produce them. P1/P2
+	  * lines are not cached: their pattern fetches can reach (nearly) all
+	  * of VRAM, so any write would invalidate every line anyway.
+	  */
+	std::vector<Pixel> lineCache;
+	std::array<std::optional<LineCacheKey>, SCREEN_HEIGHT> lineCacheKeys;
 };
 
 } // namespace openmsx
@@ -2,20 +2,26 @@
 
 #include "V9990VRAM.hh"
 
+#include "outer.hh"
+#include "ranges.hh"
 #include "serialize.hh"
+#include "xrange.hh"
+
+#include <cassert>
 
 namespace openmsx {
 
 V9990VRAM::V9990VRAM(V9990& vdp_, EmuTime::param /*time*/)
 	: vdp(vdp_)
-	, data(vdp.getDeviceConfig2(), vdp.getName() + " VRAM",
-	       "V9990 Video RAM", VRAM_SIZE)
+	, data(*vdp.getDeviceConfig2().getXML(), VRAM_SIZE)
+	, debuggable(vdp)
 {
 }
 
 void V9990VRAM::clear()
 {
 	// Initialize memory. Alternate 0x00/0xff every 512 bytes.
+	for (auto& count : blockWriteCount) ++count;
 	std::span s = data.getWriteBackdoor();
 	assert((s.size() % 1024) == 0);
 	while (!s.empty()) {
@@ -38,6 +44,33 @@ unsigned V9990VRAM::mapAddress(unsigned address) const
 	}
 }
 
+uint64_t V9990VRAM::getWriteCount(unsigned begin, unsigned end) const
+{
+	assert(begin < end);
+	assert(end <= VRAM_SIZE);
+	uint64_t sum = 0;
+	for (auto block : xrange(begin / WRITE_BLOCK_SIZE, (end - 1) / WRITE_BLOCK_SIZE + 1)) {
+		sum += blockWriteCount[block];
+	}
+	return sum;
+}
+
+uint64_t V9990VRAM::getWriteCountBx(unsigned address, unsigned size) const
+{
+	assert(0 < size);
+	assert(size <= VRAM_SIZE);
+	address &= VRAM_SIZE - 1;
+	if (address + size > VRAM_SIZE) {
+		unsigned first = VRAM_SIZE - address;
+		return getWriteCountBx(address, first) + getWriteCountBx(0, size - first);
+	}
+	// even addresses are in the lower half, odd addresses in the upper half
+	unsigned begin = address / 2;
+	unsigned end = (address + size + 1) / 2;
+	constexpr unsigned HALF = VRAM_SIZE / 2;
+	return getWriteCount(begin, end) + getWriteCount(begin + HALF, end + HALF);
+}
+
 byte V9990VRAM::readVRAMCPU(unsigned address, EmuTime::param time)
 {
 	// note: used for both normal and debug read
@@ -48,7 +81,46 @@ byte V9990VRAM::readVRAMCPU(unsigned address, EmuTime::param time)
 void V9990VRAM::writeVRAMCPU(unsigned address, byte value, EmuTime::param time)
 {
 	sync(time);
-	data.write(mapAddress(address), value);
+	writeVRAMDirect(mapAddress(address), value);
+}
+
+
+V9990VRAM::Debuggable::Debuggable(const V9990& vdp)
+	: SimpleDebuggable(vdp.getMotherBoard(), vdp.getName() + " VRAM",
+	                   "V9990 Video RAM", VRAM_SIZE)
+{
+}
+
+byte V9990VRAM::Debuggable::read(unsigned address)
+{
+	auto& vram = OUTER(V9990VRAM, debuggable);
+	return vram.readVRAMDirect(address);
+}
+
+void V9990VRAM::Debuggable::write(unsigned address, byte value)
+{
+	auto& vram = OUTER(V9990VRAM, debuggable);
+	vram.writeVRAMDirect(address, value);
+}
+
+void V9990VRAM::Debuggable::readBlock(unsigned address, std::span<byte> output)
+{
+	auto& vram = OUTER(V9990VRAM, debuggable);
+	assert((address + output.size()) <= VRAM_SIZE);
+	ranges::copy(std::span{&vram.data[address], output.size()}, output);
+}
+
+void V9990VRAM::Debuggable::writeBlock(unsigned address, std::span<const byte> input)
+{
+	auto& vram = OUTER(V9990VRAM, debuggable);
+	assert((address + input.size()) <= VRAM_SIZE);
+	if (!input.empty()) {
+		for (auto block : xrange(address / WRITE_BLOCK_SIZE,
+		                         (address + unsigned(input.size()) - 1) / WRITE_BLOCK_SIZE + 1)) {
+			++vram.blockWriteCount[block];
+		}
+	}
+	ranges::copy(input, vram.data.getWriteBackdoor().subspan(address, input.size()));
 }
 
 template<typename Archive>
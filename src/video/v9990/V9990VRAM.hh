@@ -4,9 +4,13 @@
 #include "V9990CmdEngine.hh"
 
 #include "EmuTime.hh"
+#include "SimpleDebuggable.hh"
 #include "TrackedRam.hh"
 #include "openmsx.hh"
 
+#include <array>
+#include <cstdint>
+
 namespace openmsx {
 
 class V9990;
@@ -20,6 +24,10 @@ public:
 	  */
 	static constexpr unsigned VRAM_SIZE = 512 * 1024; // 512kB
 
+	/** Granularity (in bytes) of the write counters, see getWriteCount().
+	  */
+	static constexpr unsigned WRITE_BLOCK_SIZE = 256;
+
 	/** Construct V9990 VRAM.
 	  * @param vdp The V9990 vdp this VRAM belongs to
 	  * @param time  Moment in time to create the VRAM
@@ -63,22 +71,35 @@ public:
 	}
 
 	inline void writeVRAMBx(unsigned address, byte value) {
-		data.write(transformBx(address), value);
+		writeVRAMDirect(transformBx(address), value);
 	}
 	inline void writeVRAMP1(unsigned address, byte value) {
-		data.write(transformP1(address), value);
+		writeVRAMDirect(transformP1(address), value);
 	}
 	inline void writeVRAMP2(unsigned address, byte value) {
-		data.write(transformP2(address), value);
+		writeVRAMDirect(transformP2(address), value);
 	}
 
 	[[nodiscard]] inline byte readVRAMDirect(unsigned address) const {
 		return data[address];
 	}
 	inline void writeVRAMDirect(unsigned address, byte value) {
+		++blockWriteCount[address / WRITE_BLOCK_SIZE];
 		data.write(address, value);
 	}
 
+	/** Sum of the write counters of all blocks that overlap the physical
+	  * address range [begin, end). This value changes whenever a byte in
+	  * that range is written. The renderer uses this to detect that the
+	  * VRAM content used by a display line didn't change.
+	  */
+	[[nodiscard]] uint64_t getWriteCount(unsigned begin, unsigned end) const;
+
+	/** Like getWriteCount(), but for a range of Bx addresses. The range
+	  * wraps at the end of VRAM.
+	  */
+	[[nodiscard]] uint64_t getWriteCountBx(unsigned address, unsigned size) const;
+
 	[[nodiscard]] byte readVRAMCPU(unsigned address, EmuTime::param time);
 	void writeVRAMCPU(unsigned address, byte val, EmuTime::param time);
 
@@ -100,6 +121,21 @@ private:
 	/** V9990 VRAM data.
 	  */
 	TrackedRam data;
+
+	/** Per block of WRITE_BLOCK_SIZE bytes, the number of writes to it.
+	  */
+	std::array<uint32_t, VRAM_SIZE / WRITE_BLOCK_SIZE> blockWriteCount = {};
+
+	/** Debuggable for the VRAM. Writes are also counted in
+	  * 'blockWriteCount'.
+	  */
+	struct Debuggable final : SimpleDebuggable {
+		explicit Debuggable(const V9990& vdp);
+		[[nodiscard]] byte read(unsigned address) override;
+		void write(unsigned address, byte value) override;
+		void readBlock(unsigned address, std::span<byte> output) override;
+		void writeBlock(unsigned address, std::span<const byte> input) override;
+	} debuggable;
 };
 
 } // namespace openmsx